@@ -189,3 +189,258 @@ F1(jtmemo){F1PREFIP;PROLOG(300);A h,*hv;I m;
  R z;
  // Now we have converted the verb result to recursive usecount, and gotten rid of the pending tpops for the components of h
 }
+
+// m 128!:17 creates a dictionary: a verb holding a mutable hash of keys and values.  The items of m give the type and shape of a key
+// (boolean m means integer keys); boxed m means each key is a box, whose contents are matched on type, shape, and value.  There is no tolerance.
+// D y is the values, boxed, for keys y (index error if a key is missing); x D y with x boxed puts the values x for keys y (result is 1 for each new key);
+// 0 D y deletes keys y; 1 D y tests for keys y (result is 1 for each key that was present).  For these a key of another type or shape is absent, as in 128!:18.
+// As in M., readers take a read lock on the h block and writers a write lock, so the verb may be used by several threads at once.
+// AAV(h)[0] is the hashtable, holding indexes into the other tables, -1 for empty and -2 for deleted slots.  AM has the number of slots in use, including deleted.  Allocated rank 0
+// AAV(h)[1] is the keys: for boxed keys a BOX list, otherwise an array whose items are the keys.  AM has the number of entries, including deleted
+// AAV(h)[2] is the values, a BOX list corresponding to the keys.  A deleted entry has value 0 (and key 0 if boxed).  AM has the number of entries.  Allocated rank 0
+// AAV(h)[3] is an empty array with the type and item shape of a key.  AM has the number of keys present
+#define DICTKEYT (B01+LIT+C2T+C4T+INT+FL+CMPX+SBT+INT2+INT4)  // types that can be keys or the contents of boxed keys
+#define DICTSLOT(tbl,hsh) (I)(((UIL)(UI4)(hsh)*(UIL)AN(tbl))>>32)  // starting hash index for a hash value
+#if SY_64
+#define DLOCK h->lock
+#else
+#define DLOCK jt->etxn1
+#endif
+
+// hash of n doubles.  -0 is hashed as 0, since the two are equal keys
+static UI dicthashd(D *v,I n){UI c=-1; DO(n, D d=v[i]+0.0; c=CRC32LL(c,*(UIL*)&d);) R c;}
+
+// compare n doubles: equal if == (so -0 matches 0), or if they have the same bits (so a NaN matches itself).  Result is 1 if equal
+static INLINE B dicteqd(D *u,D *v,I n){DO(n, if(u[i]!=v[i]&&memcmpne(u+i,v+i,SZD))R 0;) R 1;}
+
+// hash of a key: kb bytes at kv, or the contents of boxed key b.  fl is set if an unboxed key is FL or CMPX
+static INLINE UI dicthash(C *kv,I kb,A b,I fl){
+ if(b)R CRC32((UI4)hic(AR(b)*SZI,(UC*)AS(b)),(UI4)(AT(b)&FL+CMPX?dicthashd(DAV(b),AN(b)<<(AT(b)>>CMPXX)):hic(AN(b)<<bplg(AT(b)),UAV(b))));
+ if(fl)R dicthashd((D*)kv,kb>>LGSZD);
+ R kb==SZI?CRC32L(-1,*(UI*)kv):hic(kb,(UC*)kv);
+}
+
+// find a key in the dictionary.  Result is its entry number, or -1 if absent.  *slot is the hash slot of the key, or the slot to put it in if absent
+// Keys are matched on their bytes, except that FL and CMPX atoms are compared as numbers, as in i.!.0
+static INLINE I dictfind(A hasht,A keys,I kb,C *kv,A b,I *slot){I *hv=IAV0(hasht); I fl=!b&&AT(keys)&FL+CMPX;
+ I j=DICTSLOT(hasht,dicthash(kv,kb,b,fl)), del=-1;
+ while(1){I e=hv[j];
+  if(e==-1)break;  // empty: key is absent
+  if(e>=0){if(b){A k=AAV1(keys)[e]; if(AT(k)==AT(b)&&AR(k)==AR(b)&&!ICMP(AS(k),AS(b),AR(b))&&(AT(b)&FL+CMPX?dicteqd(DAV(k),DAV(b),AN(b)<<(AT(b)>>CMPXX)):!memcmpne(voidAV(k),voidAV(b),AN(b)<<bplg(AT(b))))){*slot=j; R e;}}
+   else if(fl?dicteqd((D*)(CAV(keys)+e*kb),(D*)kv,kb>>LGSZD):kb==SZI?((I*)CAV(keys))[e]==*(I*)kv:!memcmpne(CAV(keys)+e*kb,kv,kb)){*slot=j; R e;}  // fast compare for 8-byte keys
+  }else if(del<0)del=j;  // remember the first deleted slot, which we can reuse
+  if(unlikely(--j<0))j+=AN(hasht);
+ }
+ *slot=del<0?j:del; R -1;
+}
+
+// insert all the keys in the cleared hashtable
+static void dictrehash(A h,I kb){A hasht=AAV0(h)[0], keys=AAV0(h)[1], vals=AAV0(h)[2]; I *hv=IAV0(hasht); I bx=!!(AT(keys)&BOX);
+ DO(AM(vals), if(AAV0(vals)[i]){I j=DICTSLOT(hasht,dicthash(CAV(keys)+i*kb,kb,bx?AAV1(keys)[i]:0,!bx&&AT(keys)&FL+CMPX)); while(hv[j]!=-1){if(unlikely(--j<0))j+=AN(hasht);} hv[j]=i;})
+ AM(hasht)=AM(AAV0(h)[3]);
+}
+
+// make sure there is room to add a key.  We hold a write lock on entry, and on exit unless there was an error.  Result is 0 if error
+static I jtdictroom(J jt,A h,I kb){
+ while(1){A hasht=AAV0(h)[0], keys=AAV0(h)[1], vals=AAV0(h)[2]; I live=AM(AAV0(h)[3]);
+  if((AM(keys)==AS(keys)[0])|(AM(vals)==AN(vals))){  // no room for a new entry
+   if(live*2<=AM(vals)){  // at least half the entries are deleted.  Squeeze them out rather than extending
+    I bx=!!(AT(keys)&BOX), n=0;
+    DO(AM(vals), if(AAV0(vals)[i]){AAV0(vals)[n]=AAV0(vals)[i]; if(bx)AAV1(keys)[n]=AAV1(keys)[i];else MC(CAV(keys)+n*kb,CAV(keys)+i*kb,kb); ++n;})
+    mvc((AM(vals)-n)*SZA,AAV0(vals)+n,1,MEMSET00); if(bx)mvc((AM(vals)-n)*SZA,AAV1(keys)+n,1,MEMSET00);
+    AM(vals)=AM(keys)=n; mvc(AN(hasht)*SZI,IAV0(hasht),1,MEMSETFF); AM(hasht)=0;  // entries moved: rebuild the hash
+   }else if(AM(keys)==AS(keys)[0]){RZ(jtextendunderlock(jt,&AAV0(h)[1],&DLOCK,0)) continue;}  // extend the key table
+   else{RZ(jtextendunderlock(jt,&AAV0(h)[2],&DLOCK,0)) continue;}  // extend the value table
+  }
+  if(AM(hasht)*2>=AN(hasht)){  // hash is half full
+   if(live*2<=AM(hasht)){mvc(AN(hasht)*SZI,IAV0(hasht),1,MEMSETFF); AM(hasht)=0;}  // mostly deleted slots: rebuild in place
+   else{RZ(jtextendunderlock(jt,&AAV0(h)[0],&DLOCK,1)) continue;}  // extend the hash table, noting that it is a hash
+  }
+  if(AM(hasht)==0&&live)dictrehash(h,kb);  // rebuild the hash if it was cleared or resized
+  R 1;
+ }
+}
+
+// position of a key type among the types that can hold its values: numbers B01 INT2 INT4 INT FL CMPX, characters LIT C2T C4T.  -1 for others
+static I dictwidth(I t){
+ R t&B01?0:t&INT2?1:t&INT4?2:t&INT?3:t&FL?4:t&CMPX?5:t&LIT?10:t&C2T?11:t&C4T?12:-1;
+}
+
+// convert the atoms of w, which are INT, FL, CMPX, C2T or C4T, to the narrower type t at zv.  ok[k] is cleared for each key k (ka atoms) that holds
+// an atom with no exact equivalent in t
+static void dictnarrow(A w,I t,C *zv,B *ok,I ka){I wt=AT(w);
+ DO(AN(w), I v; B good;
+  if(wt&C2T+C4T){v=wt&C2T?USAV(w)[i]:C4AV(w)[i]; good=v<(t&LIT?256:65536);}
+  else{
+   if(wt&INT){v=IAV(w)[i]; good=1;}
+   else{D re=wt&FL?DAV(w)[i]:ZAV(w)[i].re, im=wt&FL?0.0:ZAV(w)[i].im;
+    if(t&FL){((D*)zv)[i]=re; if(im!=0.0)ok[i/ka]=0; continue;}
+    good=im==0.0&&re>=-9223372036854775808.0&&re<9223372036854775808.0&&re==(D)(I)re; v=good?(I)re:0;  // (I)re only when in range
+   }
+   good&=t&INT2?v==(I2)v:t&INT4?v==(I4)v:1;
+  }
+  if(t&LIT)((UC*)zv)[i]=(UC)v;else if(t&C2T)((US*)zv)[i]=(US)v;else if(t&INT2)((I2*)zv)[i]=(I2)v;else if(t&INT4)((I4*)zv)[i]=(I4)v;else ((I*)zv)[i]=v;
+  if(!good)ok[i/ka]=0;
+ )
+}
+
+// audit the keys y against the key prototype p.  Result is y, converted to the key type if needed.  *fr is the rank of the frame of keys, *nk the number of keys.
+// ok is 0 when the keys are to be stored or fetched: then a key that cannot be in the table is an error.  Otherwise (lookups modelled on i. e. -.) such keys
+// are absent, as in i.: *ok is set to 0 if every key can be looked up, or to a list with 0 for each key that cannot be in the table
+static A jtdictkeys(J jt,A p,A w,I *fr,I *nk,B **ok){A m=0;
+ if(ok)*ok=0;
+ if(AT(p)&BOX){
+  *fr=AR(w); *nk=AN(w);
+  if(!ok){ASSERT(AT(w)&BOX||!AN(w),EVDOMAIN) A *wv=AAV(w); DO(AN(w), ASSERT(ISDENSETYPE(AT(C(wv[i])),DICTKEYT),EVDOMAIN)) R w;}
+  GATV0(m,B01,*nk,1); *ok=BAV1(m);
+  if(!(AT(w)&BOX)){mvc(*nk,*ok,1,MEMSET00); R w;}  // a box never matches an unboxed value
+  A *wv=AAV(w); DO(AN(w), (*ok)[i]=ISDENSETYPE(AT(C(wv[i])),DICTKEYT);) R w;
+ }
+ I kr=AR(p)-1, ka; PROD(ka,kr,AS(p)+1);
+ if(!ok){ASSERT(AR(w)>=kr,EVRANK) ASSERT(!ICMP(AS(w)+AR(w)-kr,AS(p)+1,kr),EVLENGTH)}
+ *fr=MAX(AR(w)-kr,0); PROD(*nk,*fr,AS(w));  // a y of lower rank than a key is one key
+ I pw=dictwidth(AT(p)), ww=dictwidth(AT(w));
+ if(AR(w)<kr||ICMP(AS(w)+AR(w)-kr,AS(p)+1,kr)||(AN(w)&&AT(w)!=AT(p)&&((pw|ww)<0||(pw^ww)>=8))){  // shape or kind of key differs: nothing matches
+  ASSERT(ok,EVDOMAIN) GATV0(m,B01,*nk,1); *ok=BAV1(m); mvc(*nk,*ok,1,MEMSET00); R w;
+ }
+ if(AT(w)==AT(p)||!AN(w))R w;
+ if(ww<pw)R cvt(AT(p),w);  // widening is exact
+ // narrowing: atoms with no exact equivalent in the key type make their key absent (an error if storing)
+ if(AT(w)&B01+INT2+INT4)RZ(w=cvt(INT,w));
+ A z; GA(z,AT(p),AN(w),AR(w),AS(w)); GATV0(m,B01,*nk,1); B *okv=BAV1(m); mvc(*nk,okv,1,MEMSET01);
+ dictnarrow(w,AT(p),CAV(z),okv,ka);
+ if(ok)*ok=okv;else DO(*nk, ASSERT(okv[i],EVDOMAIN))
+ R z;
+}
+
+// op is 0 for get, 1 for put, 2 for delete, 3 for test
+static A jtdictop(J jt,A h,A a,A w,I op){A z;I fr,nk;
+ A p=AAV0(h)[3]; B *okv=0; RZ(w=jtdictkeys(jt,p,w,&fr,&nk,op>=2?&okv:0)); I bx=!!(AT(p)&BOX);  // a key that cannot be present is not deleted, and tests 0
+ I kb; PROD(kb,AR(p)-1,AS(p)+1); kb<<=bplg(AT(p)); kb=bx?0:kb;  // bytes in a key
+ if(op==1)ASSERT(!AR(a)||(AR(a)==fr&&!ICMP(AS(a),AS(w),fr)),EVLENGTH)  // one value per key, or a single value for all
+ GATV(z,op?B01:BOX,nk,fr,AS(w)); if(!op)AFLAGINIT(z,BOX)  // result holds the values, so it is recursive
+ C *wv=CAV(w); A *wav=AAV(w), *av=op==1?AAV(a):0; I e=0, slot;
+ if(BETWEENC(op,1,2)){  // put or delete: take the write lock
+  WRITELOCK(DLOCK)
+  DO(nk, if(okv&&!okv[i]){BAV(z)[i]=0; continue;}
+   A b=bx?C(wav[i]):0;
+   if(op==1)RZ(jtdictroom(jt,h,kb));  // error exit has released the lock
+   A hasht=AAV0(h)[0], keys=AAV0(h)[1], vals=AAV0(h)[2];
+   e=dictfind(hasht,keys,kb,wv+i*kb,b,&slot);
+   if(op==2){  // delete
+    BAV(z)[i]=e>=0; if(e<0)continue;
+    IAV0(hasht)[slot]=-2; fa(AAV0(vals)[e]); AAV0(vals)[e]=0; if(bx){fa(AAV1(keys)[e]); AAV1(keys)[e]=0;} --AM(p);
+   }else{A v=C(av[AR(a)?i:0]); ra(v);  // ra because h is recursive
+    BAV(z)[i]=e<0;
+    if(e>=0){fa(AAV0(vals)[e]); AAV0(vals)[e]=v;}  // replace the value
+    else{I n=AM(vals);  // add a new entry
+     AAV0(vals)[n]=v; if(bx){ra(b); AAV1(keys)[n]=b;}else MC(CAV(keys)+n*kb,wv+i*kb,kb);
+     AM(hasht)+=IAV0(hasht)[slot]==-1; IAV0(hasht)[slot]=n; AM(keys)=AM(vals)=n+1; ++AM(p);
+    }
+   }
+  )
+  WRITEUNLOCK(DLOCK)
+ }else{  // get or test: read lock
+  READLOCK(DLOCK)
+  A hasht=AAV0(h)[0], keys=AAV0(h)[1], vals=AAV0(h)[2];
+  DO(nk, e=okv&&!okv[i]?-1:dictfind(hasht,keys,kb,wv+i*kb,bx?C(wav[i]):0,&slot);
+   if(op){BAV(z)[i]=e>=0;}else{if(e<0)break; A v=AAV0(vals)[e]; ra(v); AAV(z)[i]=v;})
+  READUNLOCK(DLOCK)
+  ASSERT(e>=0||op,EVINDEX)  // a key to get was not found
+ }
+ RETF(z);
+}
+
+static DF1(jtdict1){ARGCHK1(w); R jtdictop(jt,FAV(self)->fgh[2],0,w,0);}
+static DF2(jtdict2){I op;
+ ARGCHK2(a,w);
+ if(AT(a)&BOX)op=1;else{ASSERT(!AR(a),EVRANK) RE(op=i0(a)); ASSERT(BETWEENC(op,0,1),EVDOMAIN) op+=2;}  // 0 is delete, 1 is test
+ R jtdictop(jt,FAV(self)->fgh[2],a,w,op);
+}
+
+// m 128!:17: create the dictionary verb, with h as described above
+F1(jtdictcreate){F1PREFIP;A h,*hv;I m;
+ ARGCHK1(w);
+ I t=AT(w); ASSERT(ISDENSETYPE(t,DICTKEYT+BOX),EVDOMAIN) t=t&B01?INT:t;
+ I kr=t&BOX?0:AR(w)-(AR(w)>0), ka; PROD(ka,kr,AS(w)+AR(w)-kr); ASSERT(ka>0,EVLENGTH)  // rank and #atoms of a key
+ FULLHASHSIZE(30,BOXSIZE,1,0,m);  // m = # hash slots to allocate
+ GAT0(h,BOX,4,0); hv=AAV0(h); AFLAGINIT(h,BOX)  // the components of fdef must be recursive if recursible
+ // as in M., the tables are extendible with # items in AM, so must be zapped, and are initialized after they have been made recursive inside fdef
+ GAT0(hv[0],INT,m,0) ACINITZAP(hv[0]) GA0(hv[1],t,(m>>1)*ka,1+kr) ACINITZAP(hv[1]) GAT0(hv[2],BOX,m>>1,0) ACINITZAP(hv[2]) GA0(hv[3],t,0,1+kr) ACINITZAP(hv[3])
+ A z=fdef(0,CIBEAM,VERB,jtdict1,jtdict2,0L,0L,h,VASGSAFE,RMAX,RMAX,RMAX); RZ(z);
+ FAV(z)->localuse.lu1.foreignmn[0]=128; FAV(z)->localuse.lu1.foreignmn[1]=17;  // display as the foreign
+ AM(hv[0])=0; mvc(m*SZI,IAV0(hv[0]),1,MEMSETFF);  // clear hash table
+ AM(hv[1])=0; AS(hv[1])[0]=m>>1; MCISH(AS(hv[1])+1,AS(w)+AR(w)-kr,kr);  // empty key table
+ AM(hv[2])=0;  // empty value table
+ AM(hv[3])=0; AS(hv[3])[0]=0; MCISH(AS(hv[3])+1,AS(w)+AR(w)-kr,kr);  // key prototype, no keys
+ R z;
+}
+
+// m 128!:18 creates an index: a verb that looks up items in a list of keys, which can be appended to without rehashing the keys already there.
+// The items of m are the initial keys.  The type and item shape of a key are fixed, and keys are matched exactly, as in 128!:17.
+// I y is keys i. y; 0 I y is y e. keys; 1 I y is y -. keys; 2 I y appends the items of y to the keys (result is the new number of keys).
+// As in i. e. -., a y of another type or item shape holds no keys; appending one is an error.
+// AAV(h)[0] is the hashtable, holding the index of the first occurrence of each distinct key, -1 for empty slots.  AM has the number of slots in use.  Allocated rank 0
+// AAV(h)[1] is the keys: for boxed keys a BOX list, otherwise an array whose items are the keys.  AM has the number of keys
+// AAV(h)[2] is an empty array with the type and item shape of a key
+// make sure there is room to add a key, as in jtdictroom
+static I jtixroom(J jt,A h,I kb){
+ while(1){A hasht=AAV0(h)[0], keys=AAV0(h)[1]; I bx=!!(AT(keys)&BOX), slot;
+  if(AM(keys)==AS(keys)[0]){RZ(jtextendunderlock(jt,&AAV0(h)[1],&DLOCK,0)) continue;}  // extend the key table
+  if(AM(hasht)*2>=AN(hasht)){RZ(jtextendunderlock(jt,&AAV0(h)[0],&DLOCK,1)) continue;}  // extend the hash table, noting that it is a hash
+  if(AM(hasht)==0&&AM(keys))DO(AM(keys), if(dictfind(hasht,keys,kb,CAV(keys)+i*kb,bx?AAV1(keys)[i]:0,&slot)<0){IAV0(hasht)[slot]=i; ++AM(hasht);})  // rehash the first occurrences after a resize
+  R 1;
+ }
+}
+
+// op is 0 for i., 1 for e., 2 for -., 3 for append
+static A jtixop(J jt,A h,A w,I op){A z;I fr,nk;
+ A p=AAV0(h)[2]; B *okv=0;
+ if(op==2){if(!AR(w))RZ(w=ravel(w)); if(AR(w)!=AR(p))R w;}  // -. works on the items of y: an atom is a list of one, and items of another rank are never keys
+ A w0=w; RZ(w=jtdictkeys(jt,p,w,&fr,&nk,op<3?&okv:0)); I bx=!!(AT(p)&BOX);  // for i. e. -. a key that cannot be present is absent
+ I kb; PROD(kb,AR(p)-1,AS(p)+1); kb<<=bplg(AT(p)); kb=bx?0:kb;  // bytes in a key
+ C *wv=CAV(w); A *wav=AAV(w); I e, slot;
+ if(op==3){  // append: take the write lock
+  WRITELOCK(DLOCK)
+  DO(nk, A b=bx?C(wav[i]):0;
+   RZ(jtixroom(jt,h,kb));  // error exit has released the lock
+   A hasht=AAV0(h)[0], keys=AAV0(h)[1]; I n=AM(keys);
+   if(bx){ra(b); AAV1(keys)[n]=b;}else MC(CAV(keys)+n*kb,wv+i*kb,kb); AM(keys)=n+1;  // ra because h is recursive
+   if(dictfind(hasht,keys,kb,wv+i*kb,b,&slot)<0){IAV0(hasht)[slot]=n; ++AM(hasht);}  // hash only the first occurrence
+  )
+  I n=AM(AAV0(h)[1]);
+  WRITEUNLOCK(DLOCK)
+  R sc(n);
+ }
+ GATV(z,op?B01:INT,nk,fr,AS(w)); I *zv=IAV(z); B *zb=BAV(z);
+ READLOCK(DLOCK)
+ A hasht=AAV0(h)[0], keys=AAV0(h)[1]; I n=AM(keys);
+ if(op)DO(nk, zb[i]=(!(okv&&!okv[i])&&dictfind(hasht,keys,kb,wv+i*kb,bx?C(wav[i]):0,&slot)>=0)^(op==2);)  // for -., 1 if the key is absent
+ else DO(nk, e=okv&&!okv[i]?-1:dictfind(hasht,keys,kb,wv+i*kb,bx?C(wav[i]):0,&slot); zv[i]=e<0?n:e;)
+ READUNLOCK(DLOCK)
+ R op==2?repeat(z,w0):z;
+}
+
+static DF1(jtix1){ARGCHK1(w); R jtixop(jt,FAV(self)->fgh[2],w,0);}
+static DF2(jtix2){I op;
+ ARGCHK2(a,w);
+ ASSERT(!AR(a),EVRANK) RE(op=i0(a)); ASSERT(BETWEENC(op,0,2),EVDOMAIN)
+ R jtixop(jt,FAV(self)->fgh[2],w,op+1);
+}
+
+// m 128!:18: create the index verb, with h as described above, and append the items of m
+F1(jtixcreate){F1PREFIP;A h,*hv;I m;
+ ARGCHK1(w);
+ I t=AT(w); ASSERT(ISDENSETYPE(t,DICTKEYT+BOX),EVDOMAIN) t=t&B01?INT:t;
+ I kr=t&BOX?0:AR(w)-(AR(w)>0), ka; PROD(ka,kr,AS(w)+AR(w)-kr); ASSERT(ka>0,EVLENGTH)  // rank and #atoms of a key
+ I nm=t&BOX?AN(w):AR(w)?AS(w)[0]:1; FULLHASHSIZE(2*nm+30,SZI,0,0,m);  // m = # hash slots to allocate, room for the keys in m
+ GAT0(h,BOX,3,0); hv=AAV0(h); AFLAGINIT(h,BOX)  // the components of fdef must be recursive if recursible
+ GATV0(hv[0],INT,m,0) ACINITZAP(hv[0]) GA0(hv[1],t,(m>>1)*ka,1+kr) ACINITZAP(hv[1]) GA0(hv[2],t,0,1+kr) ACINITZAP(hv[2])
+ A z=fdef(0,CIBEAM,VERB,jtix1,jtix2,0L,0L,h,VASGSAFE,RMAX,RMAX,RMAX); RZ(z);
+ FAV(z)->localuse.lu1.foreignmn[0]=128; FAV(z)->localuse.lu1.foreignmn[1]=18;  // display as the foreign
+ AM(hv[0])=0; mvc(m*SZI,IAV0(hv[0]),1,MEMSETFF);  // clear hash table
+ AM(hv[1])=0; AS(hv[1])[0]=m>>1; MCISH(AS(hv[1])+1,AS(w)+AR(w)-kr,kr);  // empty key table
+ AS(hv[2])[0]=0; MCISH(AS(hv[2])+1,AS(w)+AR(w)-kr,kr);  // key prototype
+ RZ(jtixop(jt,h,AR(w)?w:t&BOX?w:ravel(w),3));  // hash the keys in m
+ R z;
+}
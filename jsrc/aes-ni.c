@@ -270,6 +270,46 @@ static void block_decrypt(block_state* self, const u8* in, u8* out)
   _mm_storeu_si128((__m128i*) out, m);
 }
 
+/* 8 blocks at a time.  aesenc has a latency of several cycles but the unit can start a new one every cycle,
+   so interleaving independent blocks keeps it busy */
+#define X8(f) f(0) f(1) f(2) f(3) f(4) f(5) f(6) f(7)
+static void blocks_encrypt8(block_state* self, __m128i* m)
+{
+  int r;
+#define KX(j) m[j] = XOR(m[j], k);
+#define KE(j) m[j] = AESENC(m[j], k);
+#define KL(j) m[j] = AESENCLAST(m[j], k);
+  __m128i k = self->ek[0];
+  X8(KX)
+  for (r = 1; r < self->rounds; ++r) { k = self->ek[r]; X8(KE) }
+  k = self->ek[self->rounds];
+  X8(KL)
+#undef KE
+#undef KL
+}
+
+static void blocks_decrypt8(block_state* self, __m128i* m)
+{
+  int r;
+#define KD(j) m[j] = AESDEC(m[j], k);
+#define KL(j) m[j] = AESDECLAST(m[j], k);
+  __m128i k = self->dk[0];
+  X8(KX)
+  for (r = 1; r < self->rounds; ++r) { k = self->dk[r]; X8(KD) }
+  k = self->dk[self->rounds];
+  X8(KL)
+#undef KX
+#undef KD
+#undef KL
+}
+
+static uint64_t bswap64(uint64_t x)
+{
+  x = ((x & 0x00ff00ff00ff00ffULL) << 8) | ((x >> 8) & 0x00ff00ff00ff00ffULL);
+  x = ((x & 0x0000ffff0000ffffULL) << 16) | ((x >> 16) & 0x0000ffff0000ffffULL);
+  return (x << 32) | (x >> 32);
+}
+
 /*
   mode
   0    ECB
@@ -284,14 +324,19 @@ int aes_ni(I decrypt,I mode,UC *key,I keyn,UC* ivec,UC* out,I len)
   block_state self;
   u8 *str=out;
   I i;
+  __m128i m[8];
+#define LD(j) m[j] = _mm_loadu_si128((__m128i*)(str+i+16*j));
+#define ST(j) _mm_storeu_si128((__m128i*)(out+i+16*j), m[j]);
 
   switch(mode) {
   case 0:
     block_init(&self, key, (int)keyn);
     if(decrypt) {
-      for(i=0; i<len; i+=BLOCK_SIZE) block_decrypt(&self, str+i,out+i);
+      for(i=0; i+8*BLOCK_SIZE<=len; i+=8*BLOCK_SIZE) { X8(LD) blocks_decrypt8(&self, m); X8(ST) }
+      for(; i<len; i+=BLOCK_SIZE) block_decrypt(&self, str+i,out+i);
     } else {
-      for(i=0; i<len; i+=BLOCK_SIZE) block_encrypt(&self, str+i,out+i);
+      for(i=0; i+8*BLOCK_SIZE<=len; i+=8*BLOCK_SIZE) { X8(LD) blocks_encrypt8(&self, m); X8(ST) }
+      for(; i<len; i+=BLOCK_SIZE) block_encrypt(&self, str+i,out+i);
     }
     block_finalize(&self);
     break;
@@ -299,9 +344,18 @@ int aes_ni(I decrypt,I mode,UC *key,I keyn,UC* ivec,UC* out,I len)
   case 1:
     block_init(&self, key, (int)keyn);
     if(decrypt) {
-      __m128i iv, temp, storeNextIv;
+      /* each plaintext block needs only two ciphertext blocks, so decryption runs 8 blocks at a time */
+      __m128i iv, temp, storeNextIv, c[8];
       iv = _mm_loadu_si128((__m128i*)ivec);
-      for(i=0; i<len; i+=BLOCK_SIZE) {
+      for(i=0; i+8*BLOCK_SIZE<=len; i+=8*BLOCK_SIZE) {
+#define LDC(j) m[j] = c[j] = _mm_loadu_si128((__m128i*)(str+i+16*j));
+#define XC(j) m[j] = XOR(m[j], j ? c[j-1] : iv);
+        X8(LDC) blocks_decrypt8(&self, m); X8(XC) X8(ST)
+        iv = c[7];
+#undef LDC
+#undef XC
+      }
+      for(; i<len; i+=BLOCK_SIZE) {
         storeNextIv = _mm_loadu_si128((__m128i*)(str+i));
         block_decrypt(&self, str+i, (u8*)&temp);
         temp = XOR(temp, iv);
@@ -322,32 +376,18 @@ int aes_ni(I decrypt,I mode,UC *key,I keyn,UC* ivec,UC* out,I len)
     break;
 
   case 2: {
-    uint8_t iv[BLOCK_SIZE];
-    uint8_t buffer[BLOCK_SIZE];
-
+    /* the counter is the iv as a 128-bit big-endian number, incremented for every block */
+    uint64_t hi, lo;
+    __m128i ks[8];
     block_init(&self, key, (int)keyn);
-    memcpy(iv, ivec, BLOCK_SIZE);
-
-    uintptr_t i;
-    int bi;
-    for (i = 0, bi = BLOCK_SIZE; i < (uintptr_t)len; ++i, ++bi) {
-      if (bi == BLOCK_SIZE) { /* we need to regen xor compliment in buffer */
-
-        memcpy(buffer, iv, BLOCK_SIZE);
-        block_encrypt(&self, buffer,buffer);
-        /* Increment Iv and handle overflow */
-        for (bi = (BLOCK_SIZE - 1); bi >= 0; --bi) {
-          /* inc will overflow */
-          if (iv[bi] == 255) {
-            iv[bi] = 0;
-            continue;
-          }
-          iv[bi] += 1;
-          break;
-        }
-        bi = 0;
-      }
-      out[i] = (out[i] ^ buffer[bi]);
+    memcpy(&hi, ivec, 8); memcpy(&lo, ivec+8, 8);
+    hi = bswap64(hi); lo = bswap64(lo);
+    for(i=0; i<len; i+=8*BLOCK_SIZE) {
+#define CTR(j) ks[j] = _mm_set_epi64x((long long)bswap64(lo), (long long)bswap64(hi)); hi += !++lo;
+#define XK(j) if(i+16*j<len) _mm_storeu_si128((__m128i*)(out+i+16*j), XOR(_mm_loadu_si128((__m128i*)(str+i+16*j)), ks[j]));
+      X8(CTR) blocks_encrypt8(&self, ks); X8(XK)
+#undef CTR
+#undef XK
     }
   }
   block_finalize(&self);
@@ -357,6 +397,77 @@ int aes_ni(I decrypt,I mode,UC *key,I keyn,UC* ivec,UC* out,I len)
     R 1;
 
   }
+#undef LD
+#undef ST
 
   R 0;  // success
 }
+
+/* GHASH for AES-GCM with carry-less multiply.  Blocks are byte-reversed so the bit-reflected field elements can be
+   multiplied as ordinary polynomials; the 256-bit product is shifted left 1 and reduced mod x^128+x^7+x^2+x+1.
+   Four blocks are multiplied by H^4..H^1 and summed before one reduction */
+#if defined(__GNUC__)
+#define CLMULFN __attribute__((target("pclmul")))
+#else
+#define CLMULFN
+#endif
+
+CLMULFN static void clmul256(__m128i a, __m128i b, __m128i* lo, __m128i* hi)
+{
+  __m128i l = _mm_clmulepi64_si128(a, b, 0x00), h = _mm_clmulepi64_si128(a, b, 0x11);
+  __m128i mid = XOR(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+  *lo = XOR(*lo, XOR(l, _mm_slli_si128(mid, 8)));
+  *hi = XOR(*hi, XOR(h, _mm_srli_si128(mid, 8)));
+}
+
+CLMULFN static __m128i gfreduce(__m128i lo, __m128i hi)
+{
+  __m128i t7, t8, t9, t2;
+  /* shift the 256-bit hi:lo left one bit */
+  t7 = _mm_srli_epi32(lo, 31); t8 = _mm_srli_epi32(hi, 31);
+  lo = _mm_slli_epi32(lo, 1); hi = _mm_slli_epi32(hi, 1);
+  t9 = _mm_srli_si128(t7, 12); t8 = _mm_slli_si128(t8, 4); t7 = _mm_slli_si128(t7, 4);
+  lo = _mm_or_si128(lo, t7); hi = _mm_or_si128(hi, t8); hi = _mm_or_si128(hi, t9);
+  /* reduce */
+  t7 = XOR(XOR(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+  t8 = _mm_srli_si128(t7, 4); t7 = _mm_slli_si128(t7, 12);
+  lo = XOR(lo, t7);
+  t2 = XOR(XOR(XOR(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7)), t8);
+  return XOR(hi, XOR(lo, t2));
+}
+
+// reverse the 16 bytes, with SSE2 only
+static __m128i bswap128(__m128i x)
+{
+  x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+  x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0x1b), 0x1b);
+  return _mm_shuffle_epi32(x, 0x4e);
+}
+
+CLMULFN static __m128i gfmul_ni(__m128i a, __m128i b)
+{
+  __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+  clmul256(a, b, &lo, &hi);
+  return gfreduce(lo, hi);
+}
+
+// y = GHASH update of y (16 bytes) with the nb blocks at p, hash key h
+CLMULFN void ghash_ni(UC* y, UC* h, UC* p, I nb)
+{
+  __m128i x = bswap128(_mm_loadu_si128((__m128i*)y));
+  __m128i h1 = bswap128(_mm_loadu_si128((__m128i*)h)), h2, h3, h4;
+  I i = 0;
+  if(nb >= 4) {
+    h2 = gfmul_ni(h1, h1); h3 = gfmul_ni(h2, h1); h4 = gfmul_ni(h3, h1);
+    for(; i+4 <= nb; i += 4, p += 64) {
+      __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+      clmul256(XOR(x, bswap128(_mm_loadu_si128((__m128i*)p))), h4, &lo, &hi);
+      clmul256(bswap128(_mm_loadu_si128((__m128i*)(p+16))), h3, &lo, &hi);
+      clmul256(bswap128(_mm_loadu_si128((__m128i*)(p+32))), h2, &lo, &hi);
+      clmul256(bswap128(_mm_loadu_si128((__m128i*)(p+48))), h1, &lo, &hi);
+      x = gfreduce(lo, hi);
+    }
+  }
+  for(; i < nb; ++i, p += 16) x = gfmul_ni(XOR(x, bswap128(_mm_loadu_si128((__m128i*)p))), h1);
+  _mm_storeu_si128((__m128i*)y, bswap128(x));
+}
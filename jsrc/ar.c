@@ -370,6 +370,24 @@ REDUCEPFXIDEM2PRIM256(  mininsD, D, D, MIN, minDD, _mm256_min_pd, inf   )
 REDUCEPFX(  mininsX, X, X, XMIN, minXX, minXX  )
 REDUCEPFX(  mininsS, SB,SB,SBMIN, minSS, minSS )
 
+// SP +/ along a list accumulates in double, 8 atoms at a time, and rounds once at the end.  Other reductions stay in single precision
+AHDRR(plusinsDS,DS,DS){
+ NAN0;
+ if(d==1){DQ(m, D tot=0.0; I i=0;
+#if C_AVX2 || EMU_AVX2
+   __m256d acc0=_mm256_setzero_pd(), acc1=acc0;
+   for(;i<n-7;i+=8){__m256 xx=_mm256_loadu_ps(x+i); acc0=_mm256_add_pd(acc0,_mm256_cvtps_pd(_mm256_castps256_ps128(xx))); acc1=_mm256_add_pd(acc1,_mm256_cvtps_pd(_mm256_extractf128_ps(xx,1)));}
+   D t4[4]; _mm256_storeu_pd(t4,_mm256_add_pd(acc0,acc1)); tot=(t4[0]+t4[1])+(t4[2]+t4[3]);
+#endif
+   for(;i<n;++i)tot+=x[i];
+   *z++=(DS)tot; x+=n;)
+ }else{DQ(m, if(n==1)MC(z,x,d*sizeof(DS)); else{if(plusDSDS(1,d,x,x+d,z,jt)!=EVOK)R EVNAN; DO(n-2, if(plusDSDS(1,d,z,x+(i+2)*d,z,jt)!=EVOK)R EVNAN;)} z+=d; x+=n*d;) R EVOK;}
+ R NANTEST?EVNAN:EVOK;
+}
+REDUCEPFX( tymesinsDS, DS, DS, TYMES, tymesDSDS, tymesDSDS )
+REDUCEPFXIDEM2(  maxinsDS, DS, DS, MAX, maxDSDS )
+REDUCEPFXIDEM2(  mininsDS, DS, DS, MIN, minDSDS )
+
 // +/!.0"r, compensated summation
 static DF1(jtreduce);  // forward declaration
 DF1(jtcompsum){
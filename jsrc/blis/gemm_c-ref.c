@@ -180,8 +180,9 @@ bli_zgemm_ukn_ref(dim_t kc,
     for (j=0; j<NR; ++j) {
       dim_t i;
       for (i=0; i<MR; ++i) {
-        C[i*rs_c+j*cs_c].real = ZRE(C[i*rs_c+j*cs_c], beta);
-        C[i*rs_c+j*cs_c].imag = ZIM(C[i*rs_c+j*cs_c], beta);
+        dcomplex cij = C[i*rs_c+j*cs_c];
+        C[i*rs_c+j*cs_c].real = ZRE(cij, beta);
+        C[i*rs_c+j*cs_c].imag = ZIM(cij, beta);
       }
     }
   }
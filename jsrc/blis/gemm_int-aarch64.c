@@ -577,49 +577,41 @@ void bli_zgemm_opt_4x4
   }
 
   if (alpha.real!=1.0||alpha.imag!=0.0) {
-    b0.val[0] = vld1q_dup_f64((double*)alpha_);
-    b0.val[1] = vld1q_dup_f64(1+(double*)alpha_);
+    float64x2_t a_re = vld1q_dup_f64((double*)alpha_);
+    float64x2_t a_im = vld1q_dup_f64(1+(double*)alpha_);
+    float64x2_t t_re;
 
-    t0_00.val[0] = vfmaq_f64(t0_00.val[0] , a_0.val[0], b0.val[0]);
-    t0_01.val[0] = vfmaq_f64(t0_01.val[0] , a_1.val[0], b0.val[0]);
-    t0_02.val[0] = vfmaq_f64(t0_02.val[0] , a_2.val[0], b0.val[0]);
-    t0_03.val[0] = vfmaq_f64(t0_03.val[0] , a_3.val[0], b0.val[0]);
+    t_re = t0_00.val[0];
+    t0_00.val[0] = vfmsq_f64(vmulq_f64(t0_00.val[0], a_re), t0_00.val[1], a_im);
+    t0_00.val[1] = vfmaq_f64(vmulq_f64(t0_00.val[1], a_re), t_re, a_im);
 
-    t0_00.val[0] = vfmsq_f64(t0_00.val[0] , a_0.val[1], b0.val[1]);
-    t0_01.val[0] = vfmsq_f64(t0_01.val[0] , a_1.val[1], b0.val[1]);
-    t0_02.val[0] = vfmsq_f64(t0_02.val[0] , a_2.val[1], b0.val[1]);
-    t0_03.val[0] = vfmsq_f64(t0_03.val[0] , a_3.val[1], b0.val[1]);
+    t_re = t0_01.val[0];
+    t0_01.val[0] = vfmsq_f64(vmulq_f64(t0_01.val[0], a_re), t0_01.val[1], a_im);
+    t0_01.val[1] = vfmaq_f64(vmulq_f64(t0_01.val[1], a_re), t_re, a_im);
 
-    t0_00.val[1] = vfmaq_f64(t0_00.val[1] , a_0.val[0], b0.val[1]);
-    t0_01.val[1] = vfmaq_f64(t0_01.val[1] , a_1.val[0], b0.val[1]);
-    t0_02.val[1] = vfmaq_f64(t0_02.val[1] , a_2.val[0], b0.val[1]);
-    t0_03.val[1] = vfmaq_f64(t0_03.val[1] , a_3.val[0], b0.val[1]);
-
-    t0_00.val[1] = vfmaq_f64(t0_00.val[1] , a_0.val[1], b0.val[0]);
-    t0_01.val[1] = vfmaq_f64(t0_01.val[1] , a_1.val[1], b0.val[0]);
-    t0_02.val[1] = vfmaq_f64(t0_02.val[1] , a_2.val[1], b0.val[0]);
-    t0_03.val[1] = vfmaq_f64(t0_03.val[1] , a_3.val[1], b0.val[0]);
+    t_re = t0_02.val[0];
+    t0_02.val[0] = vfmsq_f64(vmulq_f64(t0_02.val[0], a_re), t0_02.val[1], a_im);
+    t0_02.val[1] = vfmaq_f64(vmulq_f64(t0_02.val[1], a_re), t_re, a_im);
 
-    t1_00.val[0] = vfmaq_f64(t1_00.val[0] , a_0.val[0], b0.val[0]);
-    t1_01.val[0] = vfmaq_f64(t1_01.val[0] , a_1.val[0], b0.val[0]);
-    t1_02.val[0] = vfmaq_f64(t1_02.val[0] , a_2.val[0], b0.val[0]);
-    t1_03.val[0] = vfmaq_f64(t1_03.val[0] , a_3.val[0], b0.val[0]);
+    t_re = t0_03.val[0];
+    t0_03.val[0] = vfmsq_f64(vmulq_f64(t0_03.val[0], a_re), t0_03.val[1], a_im);
+    t0_03.val[1] = vfmaq_f64(vmulq_f64(t0_03.val[1], a_re), t_re, a_im);
 
-    t1_00.val[0] = vfmsq_f64(t1_00.val[0] , a_0.val[1], b0.val[1]);
-    t1_01.val[0] = vfmsq_f64(t1_01.val[0] , a_1.val[1], b0.val[1]);
-    t1_02.val[0] = vfmsq_f64(t1_02.val[0] , a_2.val[1], b0.val[1]);
-    t1_03.val[0] = vfmsq_f64(t1_03.val[0] , a_3.val[1], b0.val[1]);
+    t_re = t1_00.val[0];
+    t1_00.val[0] = vfmsq_f64(vmulq_f64(t1_00.val[0], a_re), t1_00.val[1], a_im);
+    t1_00.val[1] = vfmaq_f64(vmulq_f64(t1_00.val[1], a_re), t_re, a_im);
 
-    t1_00.val[1] = vfmaq_f64(t1_00.val[1] , a_0.val[0], b0.val[1]);
-    t1_01.val[1] = vfmaq_f64(t1_01.val[1] , a_1.val[0], b0.val[1]);
-    t1_02.val[1] = vfmaq_f64(t1_02.val[1] , a_2.val[0], b0.val[1]);
-    t1_03.val[1] = vfmaq_f64(t1_03.val[1] , a_3.val[0], b0.val[1]);
+    t_re = t1_01.val[0];
+    t1_01.val[0] = vfmsq_f64(vmulq_f64(t1_01.val[0], a_re), t1_01.val[1], a_im);
+    t1_01.val[1] = vfmaq_f64(vmulq_f64(t1_01.val[1], a_re), t_re, a_im);
 
-    t1_00.val[1] = vfmaq_f64(t1_00.val[1] , a_0.val[1], b0.val[0]);
-    t1_01.val[1] = vfmaq_f64(t1_01.val[1] , a_1.val[1], b0.val[0]);
-    t1_02.val[1] = vfmaq_f64(t1_02.val[1] , a_2.val[1], b0.val[0]);
-    t1_03.val[1] = vfmaq_f64(t1_03.val[1] , a_3.val[1], b0.val[0]);
+    t_re = t1_02.val[0];
+    t1_02.val[0] = vfmsq_f64(vmulq_f64(t1_02.val[0], a_re), t1_02.val[1], a_im);
+    t1_02.val[1] = vfmaq_f64(vmulq_f64(t1_02.val[1], a_re), t_re, a_im);
 
+    t_re = t1_03.val[0];
+    t1_03.val[0] = vfmsq_f64(vmulq_f64(t1_03.val[0], a_re), t1_03.val[1], a_im);
+    t1_03.val[1] = vfmaq_f64(vmulq_f64(t1_03.val[1], a_re), t_re, a_im);
   }
 
   if (beta.real!=1.0||beta.imag!=0.0) {
@@ -627,8 +619,9 @@ void bli_zgemm_opt_4x4
     for (i=0; i<MR; ++i) {
       gint_t j;
       for (j=0; j<NR; ++j) {
-        c[i*rs_c+j*cs_c].real = c[i*rs_c+j*cs_c].real*beta.real - c[i*rs_c+j*cs_c].imag*beta.imag;
-        c[i*rs_c+j*cs_c].imag = c[i*rs_c+j*cs_c].real*beta.imag + c[i*rs_c+j*cs_c].imag*beta.real;
+        dcomplex cij = c[i*rs_c+j*cs_c];
+        c[i*rs_c+j*cs_c].real = cij.real*beta.real - cij.imag*beta.imag;
+        c[i*rs_c+j*cs_c].imag = cij.real*beta.imag + cij.imag*beta.real;
       }
     }
   }
@@ -728,8 +728,9 @@ void BLI_ZGEMM
     for (i=0; i<MR; ++i) {
       gint_t j;
       for (j=0; j<NR; ++j) {
-        c[i*rs_c+j*cs_c].real = c[i*rs_c+j*cs_c].real*beta.real - c[i*rs_c+j*cs_c].imag*beta.imag;
-        c[i*rs_c+j*cs_c].imag = c[i*rs_c+j*cs_c].real*beta.imag + c[i*rs_c+j*cs_c].imag*beta.real;
+        dcomplex cij = c[i*rs_c+j*cs_c];
+        c[i*rs_c+j*cs_c].real = cij.real*beta.real - cij.imag*beta.imag;
+        c[i*rs_c+j*cs_c].imag = cij.real*beta.imag + cij.imag*beta.real;
       }
     }
   }
@@ -538,8 +538,8 @@ void bli_zgemm_int_d2x2
     t0_02 = _mm_shuffle_pd ( t0_01 , t0_01 , 0x1 );
     t0_01 = _mm_mul_pd ( a_re , t0_01 );
     t0_02 = _mm_mul_pd ( a_im , t0_02 );
-    b_0 = _mm_sub_pd ( t0_01 , t0_03 );
-    b_1 = _mm_add_pd ( t0_01 , t0_03 );
+    b_0 = _mm_sub_pd ( t0_01 , t0_02 );
+    b_1 = _mm_add_pd ( t0_01 , t0_02 );
     t0_01 = _mm_shuffle_pd ( b_0 , b_1 , 0x2 );
 
     t1_02 = _mm_shuffle_pd ( t1_00 , t1_00 , 0x1 );
@@ -552,8 +552,8 @@ void bli_zgemm_int_d2x2
     t1_02 = _mm_shuffle_pd ( t1_01 , t1_01 , 0x1 );
     t1_01 = _mm_mul_pd ( a_re , t1_01 );
     t1_02 = _mm_mul_pd ( a_im , t1_02 );
-    b_0 = _mm_sub_pd ( t1_01 , t1_03 );
-    b_1 = _mm_add_pd ( t1_01 , t1_03 );
+    b_0 = _mm_sub_pd ( t1_01 , t1_02 );
+    b_1 = _mm_add_pd ( t1_01 , t1_02 );
     t1_01 = _mm_shuffle_pd ( b_0 , b_1 , 0x2 );
 
   }
@@ -563,8 +563,9 @@ void bli_zgemm_int_d2x2
     for (i=0; i<MR; ++i) {
       gint_t j;
       for (j=0; j<NR; ++j) {
-        c[i*rs_c+j*cs_c].real = c[i*rs_c+j*cs_c].real*beta.real - c[i*rs_c+j*cs_c].imag*beta.imag;
-        c[i*rs_c+j*cs_c].imag = c[i*rs_c+j*cs_c].real*beta.imag + c[i*rs_c+j*cs_c].imag*beta.real;
+        dcomplex cij = c[i*rs_c+j*cs_c];
+        c[i*rs_c+j*cs_c].real = cij.real*beta.real - cij.imag*beta.imag;
+        c[i*rs_c+j*cs_c].imag = cij.real*beta.imag + cij.imag*beta.real;
       }
     }
   }
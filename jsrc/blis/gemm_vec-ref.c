@@ -628,8 +628,8 @@ void bli_zgemm_128_3x2
     t0_02 = MM_SWAP_PD ( t0_01 , t0_01 );
     t0_01 = MM_MUL_PD ( a_re , t0_01 );
     t0_02 = MM_MUL_PD ( a_im , t0_02 );
-    b_0 = MM_SUB_PD ( t0_01 , t0_03 );
-    b_1 = MM_ADD_PD ( t0_01 , t0_03 );
+    b_0 = MM_SUB_PD ( t0_01 , t0_02 );
+    b_1 = MM_ADD_PD ( t0_01 , t0_02 );
     t0_01 = MM_SHUFFLE_PD ( b_0 , b_1 );
 
     t1_02 = MM_SWAP_PD ( t1_00 , t1_00 );
@@ -642,8 +642,8 @@ void bli_zgemm_128_3x2
     t1_02 = MM_SWAP_PD ( t1_01 , t1_01 );
     t1_01 = MM_MUL_PD ( a_re , t1_01 );
     t1_02 = MM_MUL_PD ( a_im , t1_02 );
-    b_0 = MM_SUB_PD ( t1_01 , t1_03 );
-    b_1 = MM_ADD_PD ( t1_01 , t1_03 );
+    b_0 = MM_SUB_PD ( t1_01 , t1_02 );
+    b_1 = MM_ADD_PD ( t1_01 , t1_02 );
     t1_01 = MM_SHUFFLE_PD ( b_0 , b_1 );
 
     t2_02 = MM_SWAP_PD ( t2_00 , t2_00 );
@@ -656,8 +656,8 @@ void bli_zgemm_128_3x2
     t2_02 = MM_SWAP_PD ( t2_01 , t2_01 );
     t2_01 = MM_MUL_PD ( a_re , t2_01 );
     t2_02 = MM_MUL_PD ( a_im , t2_02 );
-    b_0 = MM_SUB_PD ( t2_01 , t2_03 );
-    b_1 = MM_ADD_PD ( t2_01 , t2_03 );
+    b_0 = MM_SUB_PD ( t2_01 , t2_02 );
+    b_1 = MM_ADD_PD ( t2_01 , t2_02 );
     t2_01 = MM_SHUFFLE_PD ( b_0 , b_1 );
 
   }
@@ -667,8 +667,9 @@ void bli_zgemm_128_3x2
     for (i=0; i<MR; ++i) {
       gint_t j;
       for (j=0; j<NR; ++j) {
-        c[i*rs_c+j*cs_c].real = c[i*rs_c+j*cs_c].real*beta.real - c[i*rs_c+j*cs_c].imag*beta.imag;
-        c[i*rs_c+j*cs_c].imag = c[i*rs_c+j*cs_c].real*beta.imag + c[i*rs_c+j*cs_c].imag*beta.real;
+        dcomplex cij = c[i*rs_c+j*cs_c];
+        c[i*rs_c+j*cs_c].real = cij.real*beta.real - cij.imag*beta.imag;
+        c[i*rs_c+j*cs_c].imag = cij.real*beta.imag + cij.imag*beta.real;
       }
     }
   }
@@ -1384,6 +1384,134 @@ DF1(jtboxcutm21){
 }
 #endif //C_AVX2 && PYXES
 
+// 128!:14 split delimited text
+// x is (field separator[,record separator[,quote character]]), record separator defaults to LF, quoting is off if no quote is given.
+// y is a LIT list.  Result is a (#records,maxfields,2) table of start,length of each field in y; fields missing from a short record are (end of record),0.
+// Separators inside quotes are data.  The enclosing quotes of a quoted field are not included in its start,length (a doubled quote inside stays doubled); a CR just before an LF record separator is dropped.
+// The text is split into chunks that are scanned in parallel, 32 bytes at a time, in 3 passes: count quotes (to find the quote state at the start of each chunk);
+// count records and fields (to size the result and give each chunk its starting row/field); fill in the table.  No boxes are created.
+// 128!:14 y uses ',' LF '"' and returns one box per column, each a blank-padded table of the fields in that column with quotes removed.
+typedef struct {
+ I nq;  // number of quote characters in the chunk
+ I nrec;  // number of record separators in the chunk
+ I headf;  // number of field separators before the first record separator (all of them, if none)
+ I tailf;  // number of field separators after the last record separator
+ I maxin;  // max #fields in a record that starts and ends in the chunk
+ I lastb;  // index of the character after the last separator in the chunk, -1 if none
+ I row, fld, fstart;  // starting record#, field#, start of current field, filled in after the counting pass
+ C inq;  // 1 if the chunk starts inside quotes
+} CSVCHUNK;
+typedef struct {
+ C *wv; I n;  // the text
+ I chunksz;  // bytes per task
+ I *zv; I maxf;  // result area and its row length, for the fill pass
+ C fs, rs, qc, hasq;  // field sep, record sep, quote, 1 if quote valid
+ C pass;  // 0=count quotes, 1=count records/fields, 2=fill
+ CSVCHUNK c[];
+} CSVSTATE;
+
+// mask of the characters in the 32-byte block at s that may be structural.  If there is no quote character, qc==fs
+static INLINE UI4 csvmask(C *s, I n, C fs, C rs, C qc){UI4 m=0;
+#if C_AVX2 || EMU_AVX2
+ if(likely(n>=32)){__m256i b=_mm256_loadu_si256((__m256i*)s);
+  R (UI4)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(b,_mm256_set1_epi8(fs)),_mm256_cmpeq_epi8(b,_mm256_set1_epi8(rs))),_mm256_cmpeq_epi8(b,_mm256_set1_epi8(qc))));}
+#endif
+ DO(MIN(n,32), m|=(UI4)((s[i]==fs)|(s[i]==rs)|(s[i]==qc))<<i;) R m;  // bit i is set for s[i]
+}
+
+// store start,length of the field [b,e) at (row,fld).  Remove CR before LF, and enclosing quotes
+static INLINE void csvput(CSVSTATE *s, I row, I fld, I b, I e, I atrs){C *wv=s->wv;
+ e-=(atrs&(s->rs==CLF)&(e>b))&&wv[e-1]==CCR;
+ if(s->hasq&&e-b>=2&&wv[b]==s->qc&&wv[e-1]==s->qc){++b; --e;}
+ I *zv=s->zv+2*(row*s->maxf+fld); zv[0]=b; zv[1]=e-b;
+}
+
+// pad a record that ended at fld with empty fields at e
+static INLINE void csvpad(CSVSTATE *s, I row, I fld, I e){I *zv=s->zv+2*row*s->maxf; for(++fld;fld<s->maxf;++fld){zv[2*fld]=e; zv[2*fld+1]=0;}}
+
+static unsigned char jtcsvsplitx(J jt,void *ctx,UI4 ti){CSVSTATE *s=ctx; CSVCHUNK *c=&s->c[ti];
+ C *wv=s->wv; I b=ti*s->chunksz, e=MIN(b+s->chunksz,s->n); C fs=s->fs, rs=s->rs, qc=s->qc, hasq=s->hasq;
+ if(s->pass==0){I nq=0;  // count quotes
+#if C_AVX2 || EMU_AVX2
+  __m256i q=_mm256_set1_epi8(qc);
+  for(;b+32<=e;b+=32)nq+=__builtin_popcount((UI4)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(wv+b)),q)));
+#endif
+  for(;b<e;++b)nq+=wv[b]==qc;
+  c->nq=nq; R 0;}
+ I fill=s->pass==2; I inq=c->inq, nrec=0, nf=0, headf=-1, maxin=0, lastb=-1, row=c->row, fld=c->fld, fstart=c->fstart;
+ for(I blk=b;blk<e;blk+=32){
+  UI4 m=csvmask(wv+blk,e-blk,fs,rs,qc);
+  while(m){I p=blk+CTTZ(m); m&=m-1; C ch=wv[p];
+   if(hasq&&ch==qc){inq^=1; continue;}
+   if(inq)continue;
+   if(ch==fs){if(fill)csvput(s,row,fld,fstart,p,0); ++fld; ++nf;}
+   else{  // record separator
+    if(fill){csvput(s,row,fld,fstart,p,1); csvpad(s,row,fld,p);}
+    if(headf<0)headf=nf;else maxin=MAX(maxin,nf+1);
+    ++nrec; nf=0; ++row; fld=0;}
+   fstart=lastb=p+1;}
+ }
+ if(!fill){c->nrec=nrec; c->headf=headf<0?nf:headf; c->tailf=nf; c->maxin=maxin; c->lastb=lastb;}
+ R 0;
+}
+
+#define CSVCHUNKSZ 65536  // bytes per task
+// split w, which has been audited.  qc==fs if there is no quoting.  Result is the start,length table
+static A jtcsvsplit(J jt,A w,C fs,C rs,C qc,C hasq){A z,ctxa;
+ I n=AN(w); I nchunk=(n+CSVCHUNKSZ-1)/CSVCHUNKSZ+!n;  // always at least one task
+ GATV0(ctxa,INT,(sizeof(CSVSTATE)+nchunk*sizeof(CSVCHUNK)+SZI-1)>>LGSZI,1); CSVSTATE *ctx=(CSVSTATE*)IAV1(ctxa);
+ ctx->wv=CAV(w); ctx->n=n; ctx->chunksz=CSVCHUNKSZ; ctx->fs=fs; ctx->rs=rs; ctx->qc=qc; ctx->hasq=hasq;
+ C inq=0;
+ if(hasq){ctx->pass=0; jtjobrun(jt,jtcsvsplitx,ctx,nchunk,0);}  // count quotes in each chunk
+ DO(nchunk, ctx->c[i].inq=inq; inq^=hasq&ctx->c[i].nq;)  // quote state at start of each chunk
+ ctx->pass=1; DO(nchunk, ctx->c[i].row=ctx->c[i].fld=ctx->c[i].fstart=0;) jtjobrun(jt,jtcsvsplitx,ctx,nchunk,0);  // count records & fields
+ // give each chunk its starting position in the result, and find the shape
+ I row=0, carry=0, fstart=0, maxf=0;  // carry is #field separators in the record open at the start of the chunk
+ DO(nchunk, CSVCHUNK *c=&ctx->c[i]; c->row=row; c->fld=carry; c->fstart=fstart;
+  if(c->nrec){maxf=MAX(maxf,carry+c->headf+1); maxf=MAX(maxf,c->maxin); carry=c->tailf; row+=c->nrec;}else carry+=c->headf;
+  if(c->lastb>=0)fstart=c->lastb;)
+ I open=(fstart<n)|(carry>0); maxf=open?MAX(maxf,carry+1):maxf;  // a final record not ended by a record separator
+ I nr=row+open, zn; DPMULDE(nr,2*maxf,zn);
+ GATV0(z,INT,zn,3); AS(z)[0]=nr; AS(z)[1]=maxf; AS(z)[2]=2;
+ if(zn){
+  ctx->zv=IAV(z); ctx->maxf=maxf;
+  ctx->pass=2; jtjobrun(jt,jtcsvsplitx,ctx,nchunk,0);  // fill
+  if(open){csvput(ctx,row,carry,fstart,n,1); csvpad(ctx,row,carry,n);}
+ }
+ R z;
+}
+
+// audit x and y.  Result is the start,length table
+F2(jtcsvsplit2){F2PREFIP;
+ ARGCHK2(a,w);
+ ASSERT(AT(a)&LIT,EVDOMAIN) ASSERT(AR(a)<=1,EVRANK) ASSERT(BETWEENC(AN(a),1,3),EVLENGTH)
+ ASSERT(AT(w)&LIT||!AN(w),EVDOMAIN) ASSERT(AR(w)<=1,EVRANK)
+ C *av=CAV(a); C fs=av[0], rs=AN(a)>1?av[1]:CLF, qc=AN(a)>2?av[2]:fs;
+ ASSERT(fs!=rs&&(AN(a)<3||(qc!=fs&&qc!=rs)),EVDOMAIN)  // the characters must be distinct
+ R jtcsvsplit(jt,w,fs,rs,qc,AN(a)>2);
+}
+
+// copy the quoted field s[0..l) to d, undoubling quotes.  Result is the length of the copy; if d is 0, just return the length
+static I csvunquote(C *d, C *s, I l){I r=0;
+ for(I k=0;k<l;++k){if(d)d[r]=s[k]; ++r; k+=(s[k]=='"')&&k+1<l&&s[k+1]=='"';}
+ R r;
+}
+
+// 128!:14 y: split comma-separated text into boxed columns
+F1(jtcsvsplit1){A z,t;
+ ARGCHK1(w);
+ ASSERT(AT(w)&LIT||!AN(w),EVDOMAIN) ASSERT(AR(w)<=1,EVRANK)
+ RZ(t=jtcsvsplit(jt,w,',',CLF,'"',1));
+ I nr=AS(t)[0], nf=AS(t)[1]; I *tv=IAV(t); C *wv=CAV(w);
+ GATV0(z,BOX,nf,1); A *zv=AAV1(z);
+ DO(nf, I j=i; I wid=0;  // for each column, find the width: a field is quoted if it is preceded by a quote
+  DO(nr, I b=tv[2*(i*nf+j)], l=tv[2*(i*nf+j)+1]; if(b>0&&wv[b-1]=='"')l=csvunquote(0,wv+b,l); wid=MAX(wid,l);)
+  A col; GATV0(col,LIT,nr*wid,2); AS(col)[0]=nr; AS(col)[1]=wid; C *cv=CAV2(col); mvc(nr*wid,cv,1,iotavec-IOTAVECBEGIN+' ');
+  DO(nr, I b=tv[2*(i*nf+j)], l=tv[2*(i*nf+j)+1]; if(b>0&&wv[b-1]=='"')csvunquote(cv+i*wid,wv+b,l);else MC(cv+i*wid,wv+b,l);)
+  zv[j]=incorp(col);)
+ R z;
+}
+
 F2(jtcut){F2PREFIP;A h=0;I flag=0,k;
 // NOTE: u/. is processed using the code for u;.1 and passing the self for /. into the cut verb.  So, the self produced
 // by /. and ;.1 must be the same as far as flags etc.  For the shared case, inplacing is OK
@@ -51,6 +51,7 @@ static F2(jtpdtby){A z;B b,*u,*v,*wv;C er=0;I at,m,n,p,t,wt,zk;
   default:   ASSERT(0,EVDOMAIN);
   case CMPXX:  if(at&B01)PDTBY(Z,Z,ZINC) else PDTXB(Z,Z,ZINC,c=*u++   ); break;
   case FLX:    if(at&B01)PDTBY(D,D,DINC) else PDTXB(D,D,DINC,c=*u++   ); break;
+  case SPX:    if(at&B01)PDTBY(DS,DS,DINC) else PDTXB(DS,DS,DINC,c=*u++   ); break;
   case INTX:   if(at&B01)PDTBY(I,I,IINC) else PDTXB(I,I,IINC,c=*u++   ); 
              if(er>=EWOV){
               RZ(z=ipprep(a,w,FL,&m,&n,&p)); zk=n*sizeof(D); u=BAV(a); v=wv=BAV(w);
@@ -713,16 +714,197 @@ I cachedmmult(J jt,D* av,D* wv,D* zv,I m,I n,I p,I flgs){D c[(CACHEHEIGHT+1)*CAC
 
 #endif
 
+// Exact integer matrix product z=a +/ . * w, with a (m,p) and w (p,n) INT.  The result is accumulated in integers, so there is no float round-trip.
+// The kernel is chosen from the largest magnitudes in a and w, which bound every dot-product:
+//  if all values fit in 16 bits and no dot-product can reach 2^31, pairs of products are accumulated in 32 bits (vpmaddwd);
+//  otherwise if all values fit in 32 bits and no dot-product can reach 2^62, products are accumulated in 64 bits (vpmuldq).
+// w is packed once into panels of 8 (16-bit) or 4 (32-bit) columns; the rows of a are divided among the threads, 4 rows at a time,
+// and each task runs down 2 panels so that the panels stay in cache.  If neither bound holds the result is 0 and the caller uses its float product.
+typedef struct {
+ I *av, *wv, *zv;  // a, w, result
+ I m, n, p;  // shape
+ I *ap, *wp;  // a padded to a multiple of 4 rows (16-bit mode: 16-bit values, rows padded to an even length), w packed in panels
+ I pe, npan;  // length of a row of ap in values, number of panels (always even)
+ I rowspertask;  // multiple of 4
+ C narrow;  // 1 for 16-bit mode
+} IMMCTX;
+
+static unsigned char jtimmx(J jt,void *ctx,UI4 ti){IMMCTX *c=ctx;
+ I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->m); I n=c->n, pe=c->pe;
+ I zt[4][16];  // result block, copied to z because the last panels may run past n
+#if C_AVX2
+ if(c->narrow){I2 *ap=(I2*)c->ap, *wp=(I2*)c->wp; I kp=pe>>1;
+  for(I pan=0;pan<c->npan;pan+=2){I2 *w0=wp+pan*kp*16, *w1=w0+kp*16;
+   for(I i=b;i<e;i+=4){I2 *a0=ap+i*pe;
+    __m256i z00=_mm256_setzero_si256(), z01=z00, z10=z00, z11=z00, z20=z00, z21=z00, z30=z00, z31=z00;
+    for(I k=0;k<kp;++k){
+     __m256i v0=_mm256_loadu_si256((__m256i*)(w0+16*k)), v1=_mm256_loadu_si256((__m256i*)(w1+16*k)), s;  // 8 columns x 2 rows of w, interleaved by row
+     s=_mm256_set1_epi32(*(I4*)(a0+2*k)); z00=_mm256_add_epi32(z00,_mm256_madd_epi16(s,v0)); z01=_mm256_add_epi32(z01,_mm256_madd_epi16(s,v1));
+     s=_mm256_set1_epi32(*(I4*)(a0+pe+2*k)); z10=_mm256_add_epi32(z10,_mm256_madd_epi16(s,v0)); z11=_mm256_add_epi32(z11,_mm256_madd_epi16(s,v1));
+     s=_mm256_set1_epi32(*(I4*)(a0+2*pe+2*k)); z20=_mm256_add_epi32(z20,_mm256_madd_epi16(s,v0)); z21=_mm256_add_epi32(z21,_mm256_madd_epi16(s,v1));
+     s=_mm256_set1_epi32(*(I4*)(a0+3*pe+2*k)); z30=_mm256_add_epi32(z30,_mm256_madd_epi16(s,v0)); z31=_mm256_add_epi32(z31,_mm256_madd_epi16(s,v1));
+    }
+#define IMMST(r,j,x) _mm256_storeu_si256((__m256i*)&zt[r][j],_mm256_cvtepi32_epi64(_mm256_castsi256_si128(x))); _mm256_storeu_si256((__m256i*)&zt[r][j+4],_mm256_cvtepi32_epi64(_mm256_extracti128_si256(x,1)));
+    IMMST(0,0,z00) IMMST(0,8,z01) IMMST(1,0,z10) IMMST(1,8,z11) IMMST(2,0,z20) IMMST(2,8,z21) IMMST(3,0,z30) IMMST(3,8,z31)
+#undef IMMST
+    I nc=MIN(16,n-pan*8); for(I r=0;r<MIN(4,e-i);++r)MC(c->zv+(i+r)*n+pan*8,zt[r],nc*SZI);
+   }
+  }
+ }else{I *ap=c->ap, *wp=c->wp;
+  for(I pan=0;pan<c->npan;pan+=2){I *w0=wp+pan*pe*4, *w1=w0+pe*4;
+   for(I i=b;i<e;i+=4){I *a0=ap+i*pe;
+    __m256i z00=_mm256_setzero_si256(), z01=z00, z10=z00, z11=z00, z20=z00, z21=z00, z30=z00, z31=z00;
+    for(I k=0;k<pe;++k){
+     __m256i v0=_mm256_loadu_si256((__m256i*)(w0+4*k)), v1=_mm256_loadu_si256((__m256i*)(w1+4*k)), s;  // 4 columns of a row of w in each
+     s=_mm256_set1_epi64x(a0[k]); z00=_mm256_add_epi64(z00,_mm256_mul_epi32(s,v0)); z01=_mm256_add_epi64(z01,_mm256_mul_epi32(s,v1));
+     s=_mm256_set1_epi64x(a0[pe+k]); z10=_mm256_add_epi64(z10,_mm256_mul_epi32(s,v0)); z11=_mm256_add_epi64(z11,_mm256_mul_epi32(s,v1));
+     s=_mm256_set1_epi64x(a0[2*pe+k]); z20=_mm256_add_epi64(z20,_mm256_mul_epi32(s,v0)); z21=_mm256_add_epi64(z21,_mm256_mul_epi32(s,v1));
+     s=_mm256_set1_epi64x(a0[3*pe+k]); z30=_mm256_add_epi64(z30,_mm256_mul_epi32(s,v0)); z31=_mm256_add_epi64(z31,_mm256_mul_epi32(s,v1));
+    }
+    _mm256_storeu_si256((__m256i*)&zt[0][0],z00); _mm256_storeu_si256((__m256i*)&zt[0][4],z01); _mm256_storeu_si256((__m256i*)&zt[1][0],z10); _mm256_storeu_si256((__m256i*)&zt[1][4],z11);
+    _mm256_storeu_si256((__m256i*)&zt[2][0],z20); _mm256_storeu_si256((__m256i*)&zt[2][4],z21); _mm256_storeu_si256((__m256i*)&zt[3][0],z30); _mm256_storeu_si256((__m256i*)&zt[3][4],z31);
+    I nc=MIN(8,n-pan*4); for(I r=0;r<MIN(4,e-i);++r)MC(c->zv+(i+r)*n+pan*4,zt[r],nc*SZI);
+   }
+  }
+ }
+#else
+ // no vector unit: a row at a time, in blocks of 16 columns held in registers.  The bounds make the accumulation exact
+ I p=c->p;
+ for(I j=0;j<n;j+=16){I nc=MIN(16,n-j);
+  for(I i=b;i<e;++i){I *z0=zt[0];
+   if(c->narrow){I2 *a0=(I2*)c->ap+i*p; I4 zs[16]={0};  // 16-bit values, 32-bit totals
+    if(nc==16){for(I k=0;k<p;++k){I4 s=a0[k]; I2 *w0=(I2*)c->wp+k*n+j; DO(16, zs[i]+=s*w0[i];)}}
+    else{for(I k=0;k<p;++k){I4 s=a0[k]; I2 *w0=(I2*)c->wp+k*n+j; DO(nc, zs[i]+=s*w0[i];)}}
+    DO(16, z0[i]=zs[i];)
+   }else{I *a0=c->av+i*p, *wv=c->wv;
+    DO(16, z0[i]=0;)
+    if(nc==16){for(I k=0;k<p;++k){I s=a0[k], *w0=wv+k*n+j; DO(16, z0[i]+=s*w0[i];)}}
+    else{for(I k=0;k<p;++k){I s=a0[k], *w0=wv+k*n+j; DO(nc, z0[i]+=s*w0[i];)}}
+   }
+   MC(c->zv+i*n+j,z0,nc*SZI);
+  }
+ }
+#endif
+ R 0;
+}
+
+#define IMMMINTASK 100000  // TUNE don't start a task for fewer multiply-adds than this
+// a and w are INT, m,n,p>0.  Result is 1 if zv has been filled with the product, 0 if the values are too big for the integer kernels
+static I jtimmult(J jt,A a,A w,I *zv,I m,I n,I p){IMMCTX c;A t;
+ I *av=IAV(a), *wv=IAV(w);
+ UI amax=0, wmax=0; DO(m*p, I v=av[i]; UI u=v<0?-(UI)v:(UI)v; amax=MAX(amax,u);) DO(p*n, I v=wv[i]; UI u=v<0?-(UI)v:(UI)v; wmax=MAX(wmax,u);)
+ if((amax|wmax)>=(UI)0x80000000)R 0;
+ D bound=(D)amax*(D)wmax*(D)(p+1);  // largest possible |dot-product|, with p rounded up to even
+ if(bound>=4e18)R 0;  // could approach 2^63: use float
+ c.av=av; c.wv=wv; c.zv=zv; c.m=m; c.n=n; c.p=p; c.narrow=(amax|wmax)<0x8000&&bound<2e9;
+#if C_AVX2
+ // pack a and w
+ I m4=(m+3)&-4;
+ if(c.narrow){I pe=(p+1)&-2, kp=pe>>1, npan=((n+15)>>4)<<1; c.pe=pe; c.npan=npan;
+  GATV0(t,INT2,m4*pe,1); I2 *ap=I2AV(t); c.ap=(I*)ap; mvc(m4*pe*sizeof(I2),ap,1,MEMSET00);
+  DO(m, I2 *d=ap+i*pe; I *s=av+i*p; DO(p, d[i]=(I2)s[i];))
+  GATV0(t,INT2,npan*kp*16,1); I2 *wp=I2AV(t); c.wp=(I*)wp; mvc(npan*kp*16*sizeof(I2),wp,1,MEMSET00);
+  DO(p, I k=i; DO(n, wp[((i>>3)*kp+(k>>1))*16+(i&7)*2+(k&1)]=(I2)wv[k*n+i];))  // panel, k-pair, column, low/high k
+ }else{I npan=((n+7)>>3)<<1; c.pe=p; c.npan=npan;
+  GATV0(t,INT,m4*p,1); c.ap=IAV1(t); MC(c.ap,av,m*p*SZI); mvc((m4-m)*p*SZI,c.ap+m*p,1,MEMSET00);
+  GATV0(t,INT,npan*p*4,1); I *wp=IAV1(t); c.wp=wp; mvc(npan*p*4*SZI,wp,1,MEMSET00);
+  DO(p, I k=i; DO(n, wp[((i>>2)*p+k)*4+(i&3)]=wv[k*n+i];))  // panel, k, column
+ }
+#else
+ if(c.narrow){  // 16-bit copies of a and w
+  GATV0(t,INT2,m*p,1); I2 *ap=I2AV(t); c.ap=(I*)ap; DO(m*p, ap[i]=(I2)av[i];)
+  GATV0(t,INT2,p*n,1); I2 *wp=I2AV(t); c.wp=(I*)wp; DO(p*n, wp[i]=(I2)wv[i];)
+ }
+#endif
+ // divide the rows among the threads
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-m)&(1-nthreads)&(IMMMINTASK-m*n*p))>=0)nthreads=1;  // if only one row, one thread, or a small job, use one thread
+ c.rowspertask=(((m+nthreads-1)/nthreads)+3)&-4; nthreads=(m+c.rowspertask-1)/c.rowspertask;
+ if(nthreads>1)jtjobrun(jt,jtimmx,&c,nthreads,0);else jtimmx(jt,&c,0);
+ R 1;
+}
+#undef IMMMINTASK
+
+// Single-precision matrix product z=a +/ . * w, with a (m,p) and w (p,n) SP, accumulated in SP.
+// The rows of a are divided among the threads.  Each task runs through p in blocks of SMMKB so that the rows of w it is using stay in cache,
+// and computes 4 rows by 16 columns of z at a time with 8-wide FMA.  Result is 0 if a NaN was produced, and the caller redoes the product with 0*_ = 0
+typedef struct {
+ DS *av, *wv, *zv;  // a, w, result
+ I m, n, p;  // shape
+ I rowspertask;  // multiple of 4
+} SMMCTX;
+
+#define SMMKB 256  // TUNE rows of w in a block
+#if C_AVX2
+#define SMMFMA(x,y,z) _mm256_fmadd_ps(x,y,z)
+#else
+#define SMMFMA(x,y,z) _mm256_add_ps(_mm256_mul_ps(x,y),z)  // emulated FMA is rounded one float at a time: much slower than mul+add
+#endif
+static unsigned char jtsmmx(J jt,void *ctx,UI4 ti){SMMCTX *c=ctx;
+ I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->m); I n=c->n, p=c->p; DS *av=c->av, *wv=c->wv, *zv=c->zv;
+ for(I k0=0;k0<p;k0+=SMMKB){I kn=MIN(SMMKB,p-k0);
+  for(I i=b;i<e;i+=4){I nr=MIN(4,e-i);
+   // rows of a for this block; a short block repeats its last row, and the extra results are discarded
+   DS *a0=av+i*p+k0, *a1=av+(i+(nr>1))*p+k0, *a2=av+(i+2*(nr>2)+(nr==2))*p+k0, *a3=av+(i+nr-1)*p+k0;
+   DS *z0=zv+i*n; I j=0;
+#if C_AVX2 || EMU_AVX2
+   for(;j+16<=n;j+=16){__m256 z00,z01,z10,z11,z20,z21,z30,z31;
+    if(k0){z00=_mm256_loadu_ps(z0+j); z01=_mm256_loadu_ps(z0+j+8); z10=z00; z11=z01; z20=z00; z21=z01; z30=z00; z31=z01;
+     if(nr>1){z10=_mm256_loadu_ps(z0+n+j); z11=_mm256_loadu_ps(z0+n+j+8);}
+     if(nr>2){z20=_mm256_loadu_ps(z0+2*n+j); z21=_mm256_loadu_ps(z0+2*n+j+8);}
+     if(nr>3){z30=_mm256_loadu_ps(z0+3*n+j); z31=_mm256_loadu_ps(z0+3*n+j+8);}
+    }else{z00=z01=z10=z11=z20=z21=z30=z31=_mm256_setzero_ps();}
+    DS *w0=wv+k0*n+j;
+    DO(kn, __m256 wa=_mm256_loadu_ps(w0), wb=_mm256_loadu_ps(w0+8); w0+=n; __m256 t;
+     t=_mm256_set1_ps(a0[i]); z00=SMMFMA(t,wa,z00); z01=SMMFMA(t,wb,z01);
+     t=_mm256_set1_ps(a1[i]); z10=SMMFMA(t,wa,z10); z11=SMMFMA(t,wb,z11);
+     t=_mm256_set1_ps(a2[i]); z20=SMMFMA(t,wa,z20); z21=SMMFMA(t,wb,z21);
+     t=_mm256_set1_ps(a3[i]); z30=SMMFMA(t,wa,z30); z31=SMMFMA(t,wb,z31);)
+    _mm256_storeu_ps(z0+j,z00); _mm256_storeu_ps(z0+j+8,z01);
+    if(nr>1){_mm256_storeu_ps(z0+n+j,z10); _mm256_storeu_ps(z0+n+j+8,z11);}
+    if(nr>2){_mm256_storeu_ps(z0+2*n+j,z20); _mm256_storeu_ps(z0+2*n+j+8,z21);}
+    if(nr>3){_mm256_storeu_ps(z0+3*n+j,z30); _mm256_storeu_ps(z0+3*n+j+8,z31);}
+   }
+#endif
+   // remaining columns
+   for(;j<n;++j){DS *ar[4]={a0,a1,a2,a3};
+    DO(nr, DS *ai=ar[i]; DS s=k0?z0[i*n+j]:0; DS *w0=wv+k0*n+j; DO(kn, s+=ai[i]*w0[i*n];) z0[i*n+j]=s;)
+   }
+  }
+ }
+ R 0;
+}
+#undef SMMFMA
+#undef SMMKB
+
+#define SMMMINTASK 100000  // TUNE don't start a task for fewer multiply-adds than this
+// a and w are SP, m,n,p>0.  Result is 0 if a NaN was produced
+static I jtpdtDS(J jt,DS *zv,A a,A w,I m,I n,I p){SMMCTX c;
+ c.av=(DS*)AV(a); c.wv=(DS*)AV(w); c.zv=zv; c.m=m; c.n=n; c.p=p;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-m)&(1-nthreads)&(SMMMINTASK-m*n*p))>=0)nthreads=1;  // if only one row, one thread, or a small job, use one thread
+ c.rowspertask=(((m+nthreads-1)/nthreads)+3)&-4; nthreads=(m+c.rowspertask-1)/c.rowspertask;
+ if(nthreads>1)jtjobrun(jt,jtsmmx,&c,nthreads,0);else jtsmmx(jt,&c,0);
+ DO(m*n, if(zv[i]!=zv[i])R 0;)
+ R 1;
+}
+#undef SMMMINTASK
+
 // +/ . *
 F2(jtpdt){PROLOG(0038);A z;I ar,at,i,m,n,p,p1,t,wr,wt;
- ARGCHK2(a,w);
+ ARGCHK2(a,w); A a0=a, w0=w; I fixint=0;  // original args, in case fixed-size integers must fall back to the general product
  // ?r = rank, ?t = type (but set Boolean type for an empty argument)
  ar=AR(a); at=AT(a); at=AN(a)?at:B01;
  wr=AR(w); wt=AT(w); wt=AN(w)?wt:B01;
  if(unlikely(ISSPARSE(at|wt)))R pdtsp(a,w);  // Transfer to sparse code if either arg sparse
- if(unlikely(((at|wt)&XNUM+RAT+QP+INT2+INT4)!=0))R df2(z,a,w,atop(slash(ds(CPLUS)),qq(ds(CSTAR),v2(1L,AR(w)))));  // On nonbasic types, execute as +/@(*"(1,(wr)))
- if(unlikely(B01&(at|wt)&&TYPESNE(at,wt)&&((ar-1)|(wr-1)|(AN(a)-1)|(AN(w)-1))>=0))R pdtby(a,w);   // If exactly one arg is boolean, handle separately
- {t=maxtyped(at,wt); if(!TYPESEQ(t,AT(a))){RZ(a=cvt(t,a));} if(!TYPESEQ(t,AT(w))){RZ(w=cvt(t,w));}}  // convert args to compatible precisions, changing a and w if needed.  B01 if both empty
+ I qp=((at|wt)&QP+XNUM+RAT+CMPX)==QP;  // QP with real types: extended-precision product in vdx.c
+ if(unlikely(((at|wt)&XNUM+RAT+QP+INT1+INT2+INT4)!=0)&&!qp){
+  if((at|wt)&XNUM+RAT+QP)R df2(z,a,w,atop(slash(ds(CPLUS)),qq(ds(CSTAR),v2(1L,AR(w)))));  // On nonbasic types, execute as +/@(*"(1,(wr)))
+  // fixed-size integers are multiplied as INT, going back to the general product if the values are too big for the integer kernels
+  if(at&INT1+INT2+INT4){RZ(a=cvt(INT,a)); at=INT;} if(wt&INT1+INT2+INT4){RZ(w=cvt(INT,w)); wt=INT;} fixint=1;
+ }
+ if(unlikely(B01&(at|wt)&&TYPESNE(at,wt)&&!qp&&((ar-1)|(wr-1)|(AN(a)-1)|(AN(w)-1))>=0))R pdtby(a,w);   // If exactly one arg is boolean, handle separately
+ {t=qp?QP:maxtyped(at,wt); if(!TYPESEQ(t,AT(a))){RZ(a=cvt(t,a));} if(!TYPESEQ(t,AT(w))){RZ(w=cvt(t,w));}}  // convert args to compatible precisions, changing a and w if needed.  B01 if both empty
  ASSERT(t&NUMERIC,EVDOMAIN);
  // Allocate result area and calculate loop controls
  // m is # 1-cells of a
@@ -790,10 +972,20 @@ oflo1:
     DQ(m, I lp; I tot=0; wv=AV(w); DQ(p, DPMULD(*av++,*wv++, lp, goto oflo2;) I oc=(~tot)^lp; tot+=lp; lp^=tot; if(XANDY(oc,lp)<0)goto oflo2;) *zv++=tot;)
     AT(z)=INT; break;
 oflo2:
+    if(fixint)R df2(z,a0,w0,atop(slash(ds(CPLUS)),qq(ds(CSTAR),v2(1L,AR(w0)))));  // fixed-size integers: the general product, which signals the overflow
     // Result does not fit in INT.  Do the computation as float, with float result
     if(m)RZ(jtsumattymesprods(jt,INT,voidAV(w),voidAV(a),p,1,1,1,m,voidAV(z)));  // use +/@:*"1 .  Exchange w and a because a is the repeated arg in jtsumattymesprods.  If error, clear z (should not happen here)
    }else{
      // full matrix products
+     if(jtimmult(jt,a,w,AV(z),m,n,p)){AT(z)=INT; break;}  // exact integer product if the values are small enough
+     if(fixint){DPMULDDECLS I *zv=AV(z), *av=AV(a), *wv=AV(w);  // too big for the kernels: the exact product, checking each product and sum for overflow, so the result is INT whenever it fits
+      mvc(m*n*SZI,zv,1,MEMSET00);
+      for(I r=0;r<m;++r,zv+=n)for(I k=0;k<p;++k){I ak=*av++; if(!ak)continue; I *wr=wv+k*n;
+       DO(n, I lp; DPMULD(ak,wr[i],lp,goto fixoflo;) I t=zv[i]+lp; if(XANDY(t^zv[i],t^lp)<0)goto fixoflo; zv[i]=t;)
+      }
+      AT(z)=INT; break;
+fixoflo: R df2(z,a0,w0,atop(slash(ds(CPLUS)),qq(ds(CSTAR),v2(1L,AR(w0)))));  // too big for INT: the general product, which signals the overflow
+     }
      I probsize = m*n*(IL)p;  // This is proportional to the number of multiply-adds.  We use it to select the implementation
      if((UI)probsize < (UI)FLOAT16TOFLOAT(JT(jt,igemm_thres))){RZ(a=cvt(FL,a)); RZ(w=cvt(FL,w)); cachedmmult(jt,DAV(a),DAV(w),DAV(z),m,n,p,0);}  // Do our matrix multiply - converting   TUNE
      else {
@@ -961,6 +1153,20 @@ time1 ,&(x,y)"0 ((256 1e20 1e20 65536 > x*y) # 0 1 2 3) +/ lens
    }
   }
   break;
+ case QPX:
+  RZ(jtpdtE(jt,z,a,w,m,n,p));
+  break;
+ case SPX:
+  // SP stays SP.  If the fast product made a NaN, retry the old way in case it was _ * 0
+  if(!jtpdtDS(jt,(DS*)AV(z),a,w,m,n,p)){DS c,s,t,*u,*v,*wv,*x,*zv;
+   u=(DS*)AV(a); v=wv=(DS*)AV(w); zv=(DS*)AV(z);
+   for(i=0;i<m;++i,v=wv,zv+=n){
+           x=zv; c=*u++; DQ(n, s=*v++; *x++ =TYMES(c,s););
+    DQ(p1, x=zv; c=*u++; DQ(n, s=*v++; t=TYMES(c,s); *x+++=t;););
+   }
+   DO(m*n, ASSERT(((DS*)AV(z))[i]==((DS*)AV(z))[i],EVNAN))
+  }
+  break;
  case CMPXX:
   {NAN0;
    I probsize = m*n*(IL)p;  // This is proportional to the number of multiply-adds.  We use it to select the implementation
@@ -990,6 +1196,73 @@ time1 ,&(x,y)"0 ((256 1e20 1e20 65536 > x*y) # 0 1 2 3) +/ lens
  EPILOG(z);
 }
 
+// x +/ . *"2 y on many small real matrices.  Rather than one call to jtpdt per cell, the cells are multiplied here in one pass over the frame,
+// with each row of the result held in registers; the cells are divided among the threads.  Any other argument goes through the rank loop
+typedef struct {
+ D *av, *wv, *zv;  // arguments and result
+ I m, p, n;  // a cells are m,p; w cells p,n
+ I ncells, arep, wrep;  // #result cells; each cell of a is used for arep result cells in a row, each cell of w for wrep
+ I cellspertask;
+} PDTBCTX;
+
+#if C_AVX2
+#define PDTBFMA(x,y,z) _mm256_fmadd_pd(x,y,z)
+#else
+#define PDTBFMA(x,y,z) _mm256_add_pd(_mm256_mul_pd(x,y),z)  // emulated FMA is rounded one atom at a time: much slower than mul+add
+#endif
+#if C_AVX2 || EMU_AVX2
+// one cell when n is 4*nv.  Called with constant nv so that the row accumulators stay in registers
+static INLINE void pdtbcell4(D *z,D *a,D *w,I m,I p,I nv){
+ for(I r=0;r<m;++r){__m256d acc[4]; DO(nv, acc[i]=_mm256_setzero_pd();)
+  for(I k=0;k<p;++k){__m256d s=_mm256_set1_pd(a[r*p+k]); D *wk=w+k*4*nv; DO(nv, acc[i]=PDTBFMA(s,_mm256_loadu_pd(wk+4*i),acc[i]);)}
+  DO(nv, _mm256_storeu_pd(z+r*4*nv+4*i,acc[i]);)}
+}
+#endif
+
+static unsigned char jtpdtbx(J jt,void *ctx,UI4 ti){PDTBCTX *c=ctx;
+ I m=c->m, p=c->p, n=c->n; I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells);
+ for(I i=b;i<e;++i){D *a=c->av+(i/c->arep)*m*p, *w=c->wv+(i/c->wrep)*p*n, *z=c->zv+i*m*n;
+#if C_AVX2 || EMU_AVX2
+  switch(n){
+  case 4: pdtbcell4(z,a,w,m,p,1); continue;
+  case 8: pdtbcell4(z,a,w,m,p,2); continue;
+  case 12: pdtbcell4(z,a,w,m,p,3); continue;
+  case 16: pdtbcell4(z,a,w,m,p,4); continue;
+  }
+#endif
+  DO(m, D *zr=z+i*n; D *ar=a+i*p; DO(n, zr[i]=0.0;) DO(p, D s=ar[i]; D *wk=w+i*n; DO(n, zr[i]+=s*wk[i];)))
+ }
+ R 0;
+}
+
+#define PDTBMAX 16  // largest axis handled here
+#define PDTBMINATOMS 4096  // TUNE don't start a task for fewer multiply-adds than this
+DF2(jtpdtbatch){A z;
+ ARGCHK2(a,w);
+ A fs=FAV(self)->fgh[0]; I ar=AR(a), wr=AR(w);
+ if(((2-ar)|(2-wr))>=0)R jtpdt(jt,a,w);  // one cell each: no loop needed
+ I at=AT(a), wt=AT(w);
+ if(!(ar>=2&&wr>=2&&((at|wt)&FL)&&!((at|wt)&~(B01+INT+FL))))goto loop;  // only real tables with at least one float
+ I fr=MAX(ar,wr)-2, cf=MIN(ar,wr)-2; I *as=AS(a), *ws=AS(w);
+ I m=as[ar-2], p=as[ar-1], n=ws[wr-1];
+ if(p!=ws[wr-2]||((PDTBMAX-m)|(PDTBMAX-p)|(PDTBMAX-n)|(m-1)|(p-1)|(n-1))<0)goto loop;  // wrong or unsuitable shapes
+ DO(cf, if(as[i]!=ws[i])goto loop;)  // frames must agree
+ I na, nw; PRODX(na,ar-2,as,1) PRODX(nw,wr-2,ws,1) if((na|nw)==0)goto loop;
+ RZ(a=cvt(FL,a)); RZ(w=cvt(FL,w));
+ PDTBCTX c={DAV(a),DAV(w),0,m,p,n,MAX(na,nw),MAX(1,nw/na),MAX(1,na/nw)};  // the shorter frame repeats its cells
+ I zn; DPMULDE(c.ncells,m*n,zn); GATV0(z,FL,zn,fr+2); MCISH(AS(z),ar>wr?as:ws,fr) AS(z)[fr]=m; AS(z)[fr+1]=n; c.zv=DAV(z);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(PDTBMINATOMS-c.ncells*m*p*n))>=0)nthreads=1;  // if only one cell, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,c.ncells); c.cellspertask=(c.ncells+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtpdtbx,&c,nthreads,0);else jtpdtbx(jt,&c,0);
+ D *zv=c.zv; DO(zn, if(zv[i]!=zv[i])goto loop;)  // NaN, perhaps from 0*_: let jtpdt handle each cell
+ RETF(z);
+loop: ;
+ I l=MIN(ar,2), r=MIN(wr,2); R rank2ex(a,w,fs,l,r,l,r,FAV(fs)->valencefns[1]);
+}
+#undef PDTBMAX
+#undef PDTBMINATOMS
+
 
 #define IPBX0  0
 #define IPBX1  1
@@ -1089,6 +1362,7 @@ DF1(jtdet){DECLFG;A h=sv->fgh[2];I c,r,*s;
  ARGCHK1(w);
  r=AR(w); s=AS(w);
  A z; if(h&&1<r&&2==s[r-1]&&s[r-2]==s[r-1])R df1(z,w,h);
+ if(h&&2<r){RZ(z=jtdetbatch(jt,w)); if(z!=mark)R z;}  // many small real tables: all the determinants in one pass
  F1RANK(2,jtdet,self);
  c=2>r?1:s[1];
  R !c ? df1(z,mtv,slash(gs)) : 1==c ? CALL1(f1,ravel(w),fs) : h && c==s[0] ? gaussdet(w) : detxm(w,self); 
@@ -1122,6 +1396,13 @@ DF1(jtludecompg){F1PREFIP;PROLOG(823);
  R z;
 }
 
+#define LUMINPAR 128  // TUNE smallest real matrix that goes to the threaded blocked LU when there are worker threads
+// 128!:10 by the blocked LU with partial pivoting (in vgauss.c), for FL and CMPX.  Result is permutation ; L+U-I
+static A jtludecompb(J jt,A w){A p,z;I sgn;
+ if(!(AT(w)&FL+CMPX))RZ(w=cvt(FL,w));
+ RZ(z=jtlublk(jt,w,&p,&sgn));
+ R jlink(p,z);
+}
 
 // 128!:10 LU decomposition for square real arrays LUP=A
 // returns permutation ; L+U-I (Doolittle form)
@@ -1143,6 +1424,7 @@ DF1(jtludecomp){F1PREFIP;PROLOG(823);
  F1RANK(2,jtludecomp,self)  // if rank > 2, call rank loop
  ASSERT(AR(w)>=2,EVRANK);   // require rank>=2
  ASSERT(AS(w)[0]==AS(w)[1],EVLENGTH);  // matrix must be square
+ if(ISDENSETYPE(AT(w),CMPX)||(ISDENSETYPE(AT(w),B01+INT+FL)&&AS(w)[0]>=LUMINPAR&&(*JT(jt,jobqueue))[0].nthreads>0))R jtludecompb(jt,w);  // complex, or big enough to share among threads: blocked LU
  if((AT(w)&SPARSE+B01+INT+FL)<=0)R jtludecompg(jt,w,DUMMYSELF);  // if not real float type, use general version
  if(unlikely(!(AT(w)&FL)))RZ(w=cvt(FL,w));
  I wn=AS(w)[0];  // n=size of square matrix
@@ -1531,7 +1813,8 @@ finrle: ;
  }
  EPILOG(jlink(aresultperm,z));
 #endif
- // here if fast FP code not supported, either because we don't have AVX or the input is not float.  Fall back to general version
+ // here if fast FP code not supported, either because we don't have AVX or the input is not float.  Use the blocked LU for real arrays, else the general version
+ if(ISDENSETYPE(AT(w),B01+INT+FL))R jtludecompb(jt,w);
  R jtludecompg(jt,w,DUMMYSELF);
 }
 
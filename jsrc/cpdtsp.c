@@ -24,6 +24,108 @@ mv=: 4 : 0     NB. sparse matrix +/ .* vector
 )
 */
 
+// Threaded products of a sparse FL matrix whose axes are both sparse and whose sparse element is 0, with a dense FL vector or matrix.
+// The index matrix of such an array is sorted by row, so the starts of the runs of equal row numbers are a compressed-sparse-row layout
+// of the nonzeros, found with one pass over the rows and no copying.  Matrix-vector and matrix-matrix products give each task a range
+// of rows holding about the same number of nonzeros; vector-matrix products give each task a range of nonzeros and its own column totals.
+typedef struct {
+ I *iv;  // index matrix, (row,col) pairs
+ D *xv;  // nonzero values
+ I *rs;  // start of each distinct row in iv/xv, followed by nnz
+ I nr;  // number of distinct rows
+ I nnz;  // number of nonzeros
+ D *wv; I n;  // dense argument, and its row length (1 for a vector)
+ D *zv;  // result: nr values, or nr rows of n; for vector-matrix, n column totals for each task
+ B *seen;  // for vector-matrix, n flags for each task, set for the columns present
+ I ntasks;
+ C vm;  // 1 for vector-matrix
+} SPMVCTX;
+
+// first row r with rs[r]>=k.  rs has nr+1 ascending values
+static I spfindrow(I *rs,I nr,I k){I b=0,e=nr; while(b<e){I h=(b+e)>>1; if(rs[h]<k)b=h+1;else e=h;} R b;}
+
+static unsigned char jtspmvx(J jt,void *ctx,UI4 ti){SPMVCTX *c=ctx;
+ I kb=ti*c->nnz/c->ntasks, ke=(ti+1)*c->nnz/c->ntasks;  // this task's share of the nonzeros
+ I *iv=c->iv; D *xv=c->xv, *wv=c->wv; I n=c->n;
+ if(c->vm){D *zv=c->zv+ti*n; B *seen=c->seen+ti*n;  // dense vector (in wv) times sparse matrix: total into this task's columns
+  mvc(n*sizeof(D),zv,1,MEMSET00); mvc(n,seen,1,MEMSET00);
+  for(I k=kb;k<ke;++k){I j=iv[2*k+1]; zv[j]+=wv[iv[2*k]]*xv[k]; seen[j]=1;}
+  R 0;
+ }
+ I *rs=c->rs; I rb=spfindrow(rs,c->nr,kb), re=spfindrow(rs,c->nr,ke);  // the rows that start in our share
+ if(n==1){D *zv=c->zv;  // matrix times vector: dot-product of each row with w
+  for(I r=rb;r<re;++r){I k=rs[r], e=rs[r+1]; D t0=0.0, t1=0.0, t2=0.0, t3=0.0;
+#if C_AVX2
+   __m256d acc=_mm256_setzero_pd();
+   for(;k+4<=e;k+=4){
+    // (r0,c0,r1,c1) and (r2,c2,r3,c3) give the columns in the order c0 c2 c1 c3; the values are put in the same order
+    __m256i i01=_mm256_loadu_si256((__m256i*)(iv+2*k)), i23=_mm256_loadu_si256((__m256i*)(iv+2*k+4));
+    __m256d g=_mm256_i64gather_pd(wv,_mm256_unpackhi_epi64(i01,i23),SZD);
+    acc=_mm256_fmadd_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(xv+k),0xd8),g,acc);
+   }
+   D a4[4]; _mm256_storeu_pd(a4,acc); t0=a4[0]; t1=a4[1]; t2=a4[2]; t3=a4[3];
+#else
+   for(;k+4<=e;k+=4){t0+=xv[k]*wv[iv[2*k+1]]; t1+=xv[k+1]*wv[iv[2*k+3]]; t2+=xv[k+2]*wv[iv[2*k+5]]; t3+=xv[k+3]*wv[iv[2*k+7]];}
+#endif
+   for(;k<e;++k)t0+=xv[k]*wv[iv[2*k+1]];
+   zv[r]=(t0+t1)+(t2+t3);
+  }
+ }else{  // matrix times matrix: each result row is the sum of rows of w, weighted by the nonzeros of the row
+  for(I r=rb;r<re;++r){D *zr=c->zv+r*n; mvc(n*sizeof(D),zr,1,MEMSET00);
+   for(I k=rs[r];k<rs[r+1];++k){D x=xv[k]; D *wr=wv+iv[2*k+1]*n; I j=0;
+#if C_AVX2 || EMU_AVX2
+    __m256d xx=_mm256_set1_pd(x);
+    for(;j+4<=n;j+=4)_mm256_storeu_pd(zr+j,_mm256_add_pd(_mm256_loadu_pd(zr+j),_mm256_mul_pd(xx,_mm256_loadu_pd(wr+j))));
+#endif
+    for(;j<n;++j)zr[j]+=x*wr[j];
+   }
+  }
+ }
+ R 0;
+}
+
+#define SPMVMINTASK 65536  // TUNE don't start a task for fewer nonzeros than this
+// a is a sparse FL matrix as described above, w is a dense FL vector (mv) or matrix (mm); or, with vm set, a is the dense vector and w the sparse matrix.
+// Result is the sparse product, with the rows (columns for vm) that have nonzeros in the sparse argument.  0 if error
+static A jtpdtspx(J jt,A a,A w,C vm){A z,t,zi,zx;P*sp,*zp;SPMVCTX c;
+ A s=vm?w:a, d=vm?a:w;  // sparse and dense arguments
+ sp=PAV(s); t=SPA(sp,i); c.iv=AV(t); c.nnz=AS(t)[0]; t=SPA(sp,x); c.xv=DAV(t);
+ c.wv=DAV(d); c.vm=vm; c.n=vm?AS(s)[1]:AR(d)==2?AS(d)[1]:1;
+ // divide the nonzeros among the threads.  For vm, each task needs its own n totals, so don't use more tasks than that space repays
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(SPMVMINTASK-c.nnz))>=0)nthreads=1;  // one thread, or a small job
+ if(vm)nthreads=MAX(1,MIN(nthreads,c.nnz/MAX(1,c.n)));
+ c.ntasks=nthreads;
+ if(vm){I n=c.n;
+  GATV0(t,FL,nthreads*n,1); c.zv=DAV(t); GATV0(t,B01,nthreads*n,1); c.seen=BAV(t);
+  if(nthreads>1)jtjobrun(jt,jtspmvx,&c,nthreads,0);else jtspmvx(jt,&c,0);
+  // combine the task totals, and keep the columns that had nonzeros
+  D *zv=c.zv; B *seen=c.seen; DO(nthreads-1, D *u=zv+(i+1)*n; B *b=seen+(i+1)*n; DO(n, zv[i]+=u[i]; seen[i]|=b[i];))
+  I nc=0; DO(n, nc+=seen[i];)
+  GATV0(zi,INT,nc,2); AS(zi)[0]=nc; AS(zi)[1]=1; GATV0(zx,FL,nc,1);
+  I *ziv=AV(zi); D *zxv=DAV(zx); DO(n, if(seen[i]){*ziv++=i; *zxv++=zv[i];})
+ }else{I nr=0, *iv=c.iv;
+  // find the start of each row
+  DO(c.nnz, nr+=i==0||iv[2*i]!=iv[2*i-2];)
+  GATV0(t,INT,nr+1,1); c.rs=AV(t); c.nr=nr;
+  {I *rs=c.rs; DO(c.nnz, if(i==0||iv[2*i]!=iv[2*i-2])*rs++=i;) *rs=c.nnz;}
+  GATV0(zi,INT,nr,2); AS(zi)[0]=nr; AS(zi)[1]=1; DO(nr, AV(zi)[i]=iv[2*c.rs[i]];)
+  if(c.n==1){GATV0(zx,FL,nr,1);}else{GATV0(zx,FL,nr*c.n,2); AS(zx)[0]=nr; AS(zx)[1]=c.n;}
+  c.zv=DAV(zx);
+  if(nthreads>1)jtjobrun(jt,jtspmvx,&c,nthreads,0);else jtspmvx(jt,&c,0);
+ }
+ // a NaN can only be _*0, which is 0 in J, or _-_, which is an error.  In either case go through the general code
+ {D *zxv=DAV(zx); DO(AN(zx), if(zxv[i]!=zxv[i])R df2(z,a,w,atop(slash(ds(CPLUS)),qq(ds(CSTAR),v2(1L,AR(w))))););}
+ GASPARSE(z,FL,1,vm?1:AR(d),vm?1+AS(s):AS(s)); if(!vm&&AR(d)==2)AS(z)[1]=AS(d)[1];
+ zp=PAV(z);
+ SPB(zp,a,iv0);
+ SPB(zp,e,scf(0.0));
+ SPB(zp,i,zi);
+ SPB(zp,x,zx);
+ R z;
+}
+#undef SPMVMINTASK
+
 static F2(jtpdtspvv){A x;D*av,s,t,*wv,z;I i,*u,*u0,*uu,*v,*v0,*vv;P*ap,*wp;
  ARGCHK2(a,w);
  ap=PAV(a); x=SPA(ap,i); u=u0=AV(x); uu=u+AN(x); x=SPA(ap,x); av=DAV(x);
@@ -172,10 +274,15 @@ static F2(jtpdtspmm){A z,zi,zj,zx,zy,*old;D*axv,c,d,*dv,*wxv,*zyv;
 F2(jtpdtsp){A x;B ab=0,wb=0;P*p;
  ARGCHK2(a,w);
  ASSERT(!AR(a)||!AR(w)||AS(a)[AR(a)-1]==AS(w)[0],EVLENGTH);
+ // a dense Boolean or integer argument to a sparse FL one is converted, so that the FL kernels can be used
+ if(ISSPARSE(AT(a))&&AT(a)&FL&&!ISSPARSE(AT(w))&&AT(w)&B01+INT)RZ(w=cvt(FL,w));
+ if(ISSPARSE(AT(w))&&AT(w)&FL&&!ISSPARSE(AT(a))&&AT(a)&B01+INT)RZ(a=cvt(FL,a));
  if(AT(a)&FL&&AT(w)&FL){
   if(ISSPARSE(AT(a))){p=PAV(a); x=SPA(p,a); ab=AR(a)==AN(x)&&equ(num(0),SPA(p,e));}
   if(ISSPARSE(AT(w))){p=PAV(w); x=SPA(p,a); wb=AR(w)==AN(x)&&equ(num(0),SPA(p,e));}
  }
+ if(ab&&2==AR(a)&&!ISSPARSE(AT(w))&&BETWEENC(AR(w),1,2)&&AN(w))R jtpdtspx(jt,a,w,0);  // sparse matrix with dense vector or matrix
+ if(wb&&2==AR(w)&&!ISSPARSE(AT(a))&&1==AR(a)&&AN(a))R jtpdtspx(jt,a,w,1);  // dense vector with sparse matrix
  if(ab&&1==AR(a)&&wb&&1==AR(w))R pdtspvv(a,w);
  if(ab&&2==AR(a)&&    1==AR(w))R pdtspmv(a,w);
  if(    1==AR(a)&&wb&&2==AR(w))R pdtspvm(a,w);
@@ -348,6 +348,9 @@ void cpuInit(void)
   if ((regs[2] & (1 << 25)) != 0) {
     g_cpuFeatures |= CPU_X86_FEATURE_AES_NI;
   }
+  if ((regs[2] & (1 << 1)) != 0) {
+    g_cpuFeatures |= CPU_X86_FEATURE_PCLMUL;
+  }
   if ((regs[2] & (1 << 28)) != 0) {
     g_cpuFeatures |= CPU_X86_FEATURE_AVX;
   }
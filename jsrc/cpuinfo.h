@@ -142,6 +142,7 @@ enum {
   CPU_X86_FEATURE_AVX512IFMA  = (1 << 18),
   CPU_X86_FEATURE_AVX512VBMI  = (1 << 19),
   CPU_X86_FEATURE_AVX512VBMI2 = (1 << 20),
+  CPU_X86_FEATURE_PCLMUL      = (1 << 21),
 };
 enum {
   CPU_X86_FEATURE2_RING3MWAIT = (1 << 15),  /* MONITOR/MWAIT enabled in Ring 3 */
@@ -817,6 +817,9 @@ F2(jtqq){F2PREFIP;AF f1,f2;I hv[3],n,r[3],vf,flag2=0,*v;A ger=0;C lc=0;
     f2=jtsumattymes1; vf |= VIRS2; flag2 &= ~VF2RANKONLY2; vf &=~(VJTFLGOK2);  // switch to new routine, which supports IRS but not inplacing
    }
   }
+  if(av->valencefns[1]==jtpdt && hv[1]==2 && hv[2]==2){  // +/ . *"2: many small matrix products
+   f2=jtpdtbatch; flag2 &= ~VF2RANKONLY2; vf &=~(VJTFLGOK2);
+  }
  }
 
  // Create the derived verb.  The derived verb (u"n) inplaces if the action verb u supports inplacing; it supports IRS only for monadic rank 0
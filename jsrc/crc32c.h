@@ -2,6 +2,7 @@
 #define CRC32C_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #if defined(_WIN64)||defined(__LP64__)
 extern uint64_t crc32csb8(uint64_t crc, uint64_t value);
@@ -9,6 +10,7 @@ extern uint64_t crc32csb8(uint64_t crc, uint64_t value);
 extern uint32_t crc32csb8(uint32_t crc, uint64_t value);
 #endif
 extern uint32_t crc32csb4(uint32_t crc, uint32_t value);
+extern uint32_t crc32cbuf(uint32_t crc, const unsigned char *p, size_t n);
 
 #endif
 
@@ -44,31 +44,84 @@ typedef void ((*FMTFUN)());
 static F1(jtthxqe);
 static A jtthorn1main(J,A,A);
 
-static FMTF(jtfmtI2,I2){I x=*v;
- sprintf(s,FMTI,x);
- if('-'==s[0])s[0]=CSIGN;
+// digit pairs 00..99, for formatting 2 digits at a time
+static const C dig2[201]=
+ "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+ "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+ "8081828384858687888990919293949596979899";
+static const D p10d[23]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};  // exact
+
+// write the decimal digits of u ending just before e.  Result is the address of the first digit
+static INLINE C *fmtdigs(C *e,UI u){
+ while(u>=100){UI q=u/100; e-=2; MC(e,dig2+2*(u-100*q),2); u=q;}
+ if(u>=10){e-=2; MC(e,dig2+2*u,2);}else *--e=(C)('0'+u);
+ R e;
 }
 
-static FMTF(jtfmtI4,I4){I x=*v;
- sprintf(s,FMTI,x);
- if('-'==s[0])s[0]=CSIGN;
+// x in decimal, with _ for the sign, NUL-terminated.  Result is the length
+static I fmtdec(C *s,I x){C b[24],*e=b+sizeof(b),*p=fmtdigs(e,x<0?0-(UI)x:(UI)x);
+ if(x<0)*--p=CSIGN;
+ I n=e-p; MC(s,p,n); s[n]=0; R n;
 }
 
-static FMTF(jtfmtI,I){I x=*v;
- sprintf(s,FMTI,x);
- if('-'==s[0])s[0]=CSIGN;
+// sprintf(s,"%0.*g",p,x), for finite x and p<=15, computed exactly without the C library.  Result is the length, 0 if x is outside the range handled here
+// The p significant digits are q and the decimal exponent is xp.  Large x is rounded in integer arithmetic; smaller x is scaled by a power of 10 that is
+// exact as a D, and the product is kept exact in 2 parts so that it can be rounded correctly, ties to even as printf does
+static I fmtg(C *s,D x,I p){C b[24],*d;I nd,xp;UI q;
+ if(p>15)R 0;
+ D a=ABS(x); C *s0=s; *s='-'; s+=x<0;
+ if(a==0){if(x!=x||1/x<0)R 0; *s++='0'; *s=0; R s-s0;}
+ if(a>=p10d[p-1]){  // >= p digits before the decimal point
+  if(a>=9.2e18)R 0;
+  UI u=(UI)a; D f=a-(D)u;  // integer part, and the exact fraction
+  d=fmtdigs(b+sizeof(b),u); nd=b+sizeof(b)-d; xp=nd-1;
+  if(nd==p){q=u; q+=f>0.5||(f==0.5&&q&1);}
+  else{UI m=1; DQ(nd-p, m*=10;); q=u/m; UI r=u-q*m, h=m>>1; q+=r>h||(r==h&&(f!=0||q&1));}
+ }else if(a==(D)(UI)a){  // small integer: all its digits, no rounding
+  q=(UI)a; d=fmtdigs(b+sizeof(b),q); nd=b+sizeof(b)-d; xp=nd-1; goto emit;
+ }else{
+  UIL bits=*(UIL*)&a; I be=(I)(bits>>52)-1023; xp=(be*78913)>>18;  // floor(be*log10 2), which is the decimal exponent or 1 less
+  D h,l;
+  while(1){I k=p-1-xp; if(!BETWEENC(k,1,22))R 0;
+   TWOPROD1(a,p10d[k],h,l)  // a*10^k exactly, in [10^(p-1),10^p) if xp is right
+   if(h>p10d[p]||(h==p10d[p]&&l>=0)){++xp; continue;}
+   if(h<p10d[p-1]||(h==p10d[p-1]&&l<0)){--xp; continue;}
+   break;
+  }
+  D r=rint(h), dr=h-r;  // round to nearest even; a tie in h is not a tie if l is nonzero
+  r+=(dr==0.5)&(l>0); r-=(dr==-0.5)&(l<0);
+  q=(UI)r;
+ }
+ if(q>=(UI)p10d[p]){q/=10; ++xp;}  // rounded up to 10^p
+ d=fmtdigs(b+sizeof(b),q); nd=p;
+emit: ;
+ while(nd>1&&d[nd-1]=='0')--nd;  // drop trailing zeros
+ if(xp<-4||xp>=p){  // scientific
+  *s++=d[0]; if(nd>1){*s++='.'; MC(s,d+1,nd-1); s+=nd-1;}
+  *s++='e'; *s++=xp<0?'-':'+'; I ax=ABS(xp); if(ax<10)*s++='0'; C *t=fmtdigs(b+sizeof(b),ax); I nt=b+sizeof(b)-t; MC(s,t,nt); s+=nt;
+ }else if(xp>=0){  // decimal point within or after the digits
+  if(nd<=xp+1){MC(s,d,nd); s+=nd; mvc(xp+1-nd,s,1,"0"); s+=xp+1-nd;}
+  else{MC(s,d,xp+1); s+=xp+1; *s++='.'; MC(s,d+xp+1,nd-xp-1); s+=nd-xp-1;}
+ }else{*s++='0'; *s++='.'; DQ(-xp-1, *s++='0';); MC(s,d,nd); s+=nd;}
+ *s=0; R s-s0;
 }
 
+static FMTF(jtfmtI2,I2){fmtdec(s,*v);}
+
+static FMTF(jtfmtI4,I4){fmtdec(s,*v);}
+
+static FMTF(jtfmtI,I){fmtdec(s,*v);}
+
 static FMTF(jtfmtD,D){B q;C buf[1+WD],c,*t;D x=*v;I k=0;
  if(!memcmpne(v,&inf, SZD)){strcpy(s,"_" ); R;}  // require exact bitmatch
  if(!memcmpne(v,&infm,SZD)){strcpy(s,"__"); R;}
  if(_isnan(*v)          ){strcpy(s,"_."); R;}
 // x=*v; x=x==*(D*)minus0?0.0:x;  /* -0 to 0*/
  x=*v; x=x==(-1)*0.0?0.0:x;  /* -0 to 0*/
- sprintf(buf,"%0.*g",jt->ppn,x);
+ if(!fmtg(buf,x,jt->ppn))sprintf(buf,"%0.*g",jt->ppn,x);
  c=*buf; if(q=c=='-')*s++=CSIGN; q=q|(c=='+');  // set q if sign shown
  if('.'==buf[q])*s++='0';  // add leading 0 to .ddd
- MC(s,buf+q,WD+1-q);
+ strcpy(s,buf+q);  // not past the NUL: the numbers may be formatted side by side in different tasks
  if(t=strchr(s,'e')){   // t=address of 'e' in exponent.  If there is an exponent...
   if('-'==*++t)*t++=CSIGN;  // change sign character of exponent
   NOUNROLL while(c=t[k],c=='0'||c=='+')k++;   // find index of first nonskipped char
@@ -186,6 +239,7 @@ static void thcase(I t,I*wd,FMTFUN *fmt){
 // Result  is # chars copied
 I jtthv(J jt,A w,I n,C*s){A t;B ov=0;C buf[WZ],*x,*y=s;I dec=REPSGN(n);n=n^dec;I k,n4=n-4,p,wd,wn,wt;FMTFUN fmt;
  RZ(w&&n);
+ if(AT(w)&SP)RZ(w=cvt(FL,w));  // SP is displayed as FL
  wn=AN(w); wt=AT(w); x=CAV(w); thcase(wt,&wd,&fmt);
  I isiz=2;  // will be size of integer in bytes
  switch(CTTZNOFLAG(wt)){
@@ -199,9 +253,8 @@ I jtthv(J jt,A w,I n,C*s){A t;B ov=0;C buf[WZ],*x,*y=s;I dec=REPSGN(n);n=n^dec;I
    v=IAV(w);
    for(i=0;i<wn;++i){
     t=buf; x=*v; v=(I*)((I)v+isiz); x=(x<<((SZI-isiz)<<3))>>((SZI-isiz)<<3); orv|=x;
-    sprintf(t,FMTI" ",x);
-    if('-'==*t)*t=CSIGN;
-    p=strlen(t); if(ov=n4<p+y-s)break; strcpy(y,t); y+=p;
+    p=fmtdec(t,x); t[p++]=' '; t[p]=0;
+    if(ov=n4<p+y-s)break; strcpy(y,t); y+=p;
    }
    // if all the values were boolean, prepend a 0 to the last (if there is room and list not empty)
    if(dec&&!ov&&i&&!(orv&~1)){if(!(ov=n4<y-s)){y[-1]=y[-2]; y[-2]='0';}}
@@ -238,23 +291,61 @@ static F1(jtthb){A z;B*x;C*y;I c,m,n,p,r,*s;
  RETF(z);
 }
 
-// default for for numerics
-static F1(jtthn){A d,t,z;C*tv,*x,*y,*zv;I c,*dv,k,m,n,p,r,*s,wd;FMTFUN fmt;
+typedef struct {
+ J jt;  // the caller's jt, which has the print precision
+ C *wv; I k;  // the numbers, and bytes per atom
+ C *tv; I wd; FMTFUN fmt;  // work area with wd bytes for each atom, and the formatting routine
+ I m, c, pertask;  // number of rows, atoms per row, rows given to each task.  A list is formatted as m rows of 1 atom
+ I *dv;  // max width of each column, one set per task.  For a list, the length of the text made by each task, then its offset in the result
+ C *zv; I p;  // result, and its row length
+ C list, pass;  // 1 if w is a list; 0=format the numbers, 1=copy the text into the result
+} THNCTX;
+
+static unsigned char jtthnx(J jt,void *ctx,UI4 ti){THNCTX *c=ctx;
+ I b=ti*c->pertask, e=MIN(b+c->pertask,c->m), nc=c->c, wd=c->wd, k=c->k; C *y=c->tv+b*nc*wd;
+ if(b>=e)R 0;
+ if(c->list){
+  // format the atoms packed, each followed by a space; then copy the text to its place in the result
+  if(!c->pass){C *x=c->wv+b*k,*y0=y; DQ(e-b, c->fmt(c->jt,y,x); y+=strlen(y); *y++=' '; x+=k;) c->dv[ti]=y-y0;}
+  else MC(c->zv+c->dv[ti],y,c->dv[ti+1]-c->dv[ti]);
+ }else if(!c->pass){C *x=c->wv+b*nc*k; I *dv=c->dv+ti*nc;
+  DQ(e-b, DO(nc, c->fmt(c->jt,y,x); I p=strlen(y); dv[i]=MAX(dv[i],p); y+=wd; x+=k;))  // convert each number, remember max len in each column
+ }else{I *dv=c->dv; C *zv=c->zv+b*c->p;
+  mvc((e-b)*c->p,zv,1,iotavec-IOTAVECBEGIN+' ');  // fill our rows with blanks
+  DQ(e-b, DO(nc, zv+=dv[i]; I p=strlen(y); MC(zv-p-(I )(nc>1+i),y,p); y+=wd;))  // copy each string after alignment
+ }
+ R 0;
+}
+
+#define THNMINATOMS 4096  // TUNE a list shorter than this is formatted in one piece; no task gets fewer atoms than this
+// default for for numerics.  The numbers are formatted by rows, divided among the threads of threadpool 0, and the text is copied straight into the result
+static F1(jtthn){A d,t,z;C*tv;I c,*dv,m,n,p,r,*s,wd;FMTFUN fmt;THNCTX ctx;
  n=AN(w); r=AR(w); s=AS(w);
  thcase(AT(w),&wd,&fmt);  // get default field width and routine address
  GATV0(t,LIT,wd*(1+n),1); tv=CAV(t);
- if(1>=r){p=thv(w,AN(t),tv); ASSERTSYS(p,"thn"); AN(t)=AS(t)[0]=p; z=t;}   // rank<2, just format one string of characters, separated by 1 space
- else{ 
-  c=s[r-1]; m=n/c; k=bpnoun(AT(w));  // c=length of row, m=#rows, k=size in bytes of atom
-  y=tv-wd; x=CAV(w)-k; 
-  RZ(d=apvwr(c,1L,0L)); dv=AV(d);
-  DO(m, DO(c, fmt(jt,y+=wd,x+=k); p=strlen(y); dv[i]=MAX(dv[i],p);););  // convert each number, remember max len in each column
-  --dv[c-1]; p=0; DO(c, p+=++dv[i];);
-  GATV(z,LIT,m*p,r+!r,s); AS(z)[AR(z)-1]=p; zv=CAV(z); mvc(AN(z),zv,1,iotavec-IOTAVECBEGIN+' ');  // allocate final result, fill with blanks
-  y=tv; DO(m, DO(c, zv+=dv[i]; p=strlen(y); MC(zv-p-(I )(c>1+i),y,p); y+=wd;););  // copy each string after alignment
+ if(1>=r&&n<THNMINATOMS){p=thv(w,AN(t),tv); ASSERTSYS(p,"thn"); AN(t)=AS(t)[0]=p; z=t;}   // short list, just format one string of characters, separated by 1 space
+ else{
+  c=1>=r?1:s[r-1]; m=n/c;  // c=length of row, m=#rows
+  I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+  if(((1-nthreads)&(THNMINATOMS-n))>=0)nthreads=1;  // one thread, or a small job: format in this thread
+  nthreads=MIN(nthreads,MAX(1,n/THNMINATOMS)); nthreads=MIN(nthreads,m);
+  ctx.jt=jt; ctx.wv=CAV(w); ctx.k=bpnoun(AT(w)); ctx.tv=tv; ctx.wd=wd; ctx.fmt=fmt; ctx.m=m; ctx.c=c; ctx.pertask=(m+nthreads-1)/nthreads; ctx.list=1>=r;
+  GATV0(d,INT,nthreads*c+1,1); dv=ctx.dv=IAV(d); mvc((nthreads*c+1)*SZI,dv,1,MEMSET00);
+  ctx.pass=0; if(nthreads>1)jtjobrun(jt,jtthnx,&ctx,nthreads,0);else jtthnx(jt,&ctx,0);
+  if(ctx.list){
+   p=0; DO(nthreads, I l=dv[i]; dv[i]=p; p+=l;) dv[nthreads]=p;  // offset of each task's text
+   GATV0(z,LIT,p,1); AN(z)=AS(z)[0]=p-1;  // the last space is not part of the result
+  }else{
+   DO(nthreads-1, I *v=dv+(i+1)*c; DO(c, dv[i]=MAX(dv[i],v[i]);))  // combine the column widths from the tasks
+   --dv[c-1]; p=0; DO(c, p+=++dv[i];);
+   GATV(z,LIT,m*p,r+!r,s); AS(z)[AR(z)-1]=p;  // allocate final result
+  }
+  ctx.zv=CAV(z); ctx.p=p;
+  ctx.pass=1; if(nthreads>1)jtjobrun(jt,jtthnx,&ctx,nthreads,0);else jtthnx(jt,&ctx,0);
  }
  RETF(z);
 }
+#undef THNMINATOMS
 
 // cvt SB string to utf8
 // return byte length and display width
@@ -613,6 +704,7 @@ static A jtthorn1main(J jt,A w,A prxthornuni){PROLOG(0001);A z;
  else switch(CTTZ(AT(w))){
   case INT2X: case INT4X: case INTX:  case FLX: case CMPXX:  case QPX:
              z=thn(w);                    break;
+  case SPX:  RZ(w=cvt(FL,w)); z=thn(w);   break;
 #ifdef UNDER_CE
   default:
    R 0; break;
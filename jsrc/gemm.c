@@ -652,7 +652,7 @@ zgeaxpy(dim_t         m,
             for (i=0; i<m; ++i) {
 //              Y[i*rs_y+j*cs_y] += alpha*X[i*rs_x+j*cs_x];
                 Y[i*rs_y+j*cs_y].real += ZRE(alpha,X[i*rs_x+j*cs_x]);
-                Y[i*rs_y+j*cs_y].real += ZIM(alpha,X[i*rs_x+j*cs_x]);
+                Y[i*rs_y+j*cs_y].imag += ZIM(alpha,X[i*rs_x+j*cs_x]);
             }
         }
     } else {
@@ -687,8 +687,9 @@ zgescal(dim_t   m,
             dim_t i;
             for (i=0; i<m; ++i) {
 //              X[i*rs_x+j*cs_x] *= beta;
-                X[i*rs_x+j*cs_x].real = ZRE(X[i*rs_x+j*cs_x], beta);
-                X[i*rs_x+j*cs_x].imag = ZIM(X[i*rs_x+j*cs_x], beta);
+                dcomplex xij = X[i*rs_x+j*cs_x];
+                X[i*rs_x+j*cs_x].real = ZRE(xij, beta);
+                X[i*rs_x+j*cs_x].imag = ZIM(xij, beta);
             }
         }
     } else {
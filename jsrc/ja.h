@@ -548,6 +548,7 @@ extern void jfree4gmp(void*,size_t);
 #define i0(x)                       jti0(jt,(x))
 #define iaddr(x0,x1,x2,x3)          jtiaddr(jt,(x0),(x1),(x2),(x3))
 #define icap(x)                     jticap(jt,(x),ds(CICAP))
+#define icapcompile(x)              jticapcompile(jt,(x))
 #define icor(x,y)                   jticor(jt,(x),(y))  
 #define icube(x)                    jticube(jt,(x))
 #define icvt(x)                     jticvt(jt,(x))    
@@ -877,6 +878,8 @@ extern void jfree4gmp(void*,size_t);
 #define pscan(x,y)                  jtpscan(jt,(x),(y))
 #define pscangt(x0,x1,x2,x3,x4,x5)         jtpscangt(jt,(x0),(x1),(x2),(x3),(x4),(x5))
 #define pscanlt(x0,x1,x2,x3,x4,x5)  jtpscanlt(jt,(x0),(x1),(x2),(x3),(x4),(x5))
+#define px_init(x)                  jtpx_init(jt,(x))
+#define pxfill(x,y)                 jtpxfill(jt,(x),(y))
 #define qbin(x,y)                   jtqbin(jt,(x),(y))
 #define qco2(x,y)                   jtqco2(jt,(x),(y))
 #define qco2x(x,y)                  jtqco2x(jt,(x),(y))
@@ -1032,6 +1035,7 @@ extern void jfree4gmp(void*,size_t);
 #define rotate(x,y)                 jtrotate(jt,(x),(y)) 
 #define rotsp(x,y)                  jtrotsp(jt,(x),(y))
 #define roundID(x,y)                jtroundID(jt,(x),(y))
+#define roundIDq(x,y)               jtroundIDq(jt,(x),(y))
 #define rrv(x)                      ((UI)((x)->lrr)&RANKTMSK)  // rr of V
 #define rr(x)                       rrv(FAV(x))  // rr of A
 #define rsh0(x)                     jtrsh0(jt,(x))
@@ -1043,12 +1047,14 @@ extern void jfree4gmp(void*,size_t);
 #define sbcheck1(x0,x1,x2,x3,x4,x5,x6,x7,x8)           jtsbcheck1(jt,(x0),(x1),(x2),(x3),(x4),(x5),(x6),(x7),(x8))
 #define sbcheck2(x0,x1,x2,x3)       jtsbcheck2(jt,(x0),(x1),(x2),(x3))
 #define sbextend(x0,x1,x2,x3)       jtsbextend(jt,(x0),(x1),(x2),(x3))
+#define sbfind(x)                   jtsbfind(jt,(x))
 #define sbgetdata(x)                jtsbgetdata(jt,(x))
 #define sbhashstat(x)               jtsbhashstat(jt,(x))
-#define sbinsert(x0,x1,x2,x3,x4) jtsbinsert(jt,(x0),(x1),(x2),(x3),(x4))
+#define sbinsert(x)                 jtsbinsert(jt,(x))
 #define sblit(x,y)                  jtsblit(jt,(x),(y))
 #define sborder(x)                  jtsborder(jt,(x))
 #define sbprobe(x0,x1,x2,x3)        jtsbprobe(jt,(x0),(x1),(x2),(x3))
+#define sbprobemany(x,y,z)          jtsbprobemany(jt,(x),(y),(z))
 #define sbsetdata(x)                jtsbsetdata(jt,(x))
 #define sbsetdata2(x)               jtsbsetdata2(jt,(x))
 #define sbstr(x,y)                  jtsbstr(jt,(x),(y))
@@ -1146,6 +1152,7 @@ extern void jfree4gmp(void*,size_t);
 #define sprinit(x0,x1,x2,x3,x4)     jtsprinit(jt,(x0),(x1),(x2),(x3),(x4))
 #define sprintfeD(x0,x1,x2,x3,x4)   jtsprintfeD(jt,(x0),(x1),(x2),(x3),(x4))
 #define sprintfnD(x0,x1,x2,x3,x4)   jtsprintfnD(jt,(x0),(x1),(x2),(x3),(x4))
+#define sprintfnI(x0,x1,x2,x3,x4)   jtsprintfnI(jt,(x0),(x1),(x2),(x3),(x4))
 #define sprintfI(x0,x1,x2,x3,x4)    jtsprintfI(jt,(x0),(x1),(x2),(x3),(x4))
 #define sprz(x0,x1,x2,x3,x4)        jtsprz(jt,(x0),(x1),(x2),(x3),(x4))
 #define spspd(x0,x1,x2,x3)          jtspspd(jt,(x0),(x1),(x2),(x3))
@@ -25,6 +25,10 @@ extern F1(jtbase1);
 extern F1(jtbdot);
 extern F1(jtbehead);
 extern F1(jtbinrep1);
+extern DF1(jtbitcount1);
+extern DF1(jtbitindex1);
+extern F1(jtbitlogic);
+extern DF1(jtbitpack1);
 // extern F1(jtbitadv);
 extern F1(jtbox);
 extern F1(jtboxopen);
@@ -62,6 +66,7 @@ extern DF1(jtcompsum);
 extern F1(jtcpufeature);
 extern F1(jtcrc1);
 extern F1(jtcrccompile);
+extern F1(jtcsvsplit1);
 extern F1(jtcreatecachedref);
 extern F1(jtctq);
 extern F1(jtcts);
@@ -96,6 +101,7 @@ extern F1(jtdecrem);
 extern F1(jtdenseit);
 extern DF1(jtdet);
 extern F1(jtdgrade1);
+extern F1(jtdictcreate);
 extern F1(jtdigits10);
 extern F1(jtdispq);
 extern F1(jtdisps);
@@ -119,6 +125,7 @@ extern F1(jtexg);
 // extern F1(jtexpn1);
 // extern F1(jtfact);
 extern F1(jtfactor);
+extern F1(jtfft1);
 extern F1(jtfh15);
 extern F1(jtfiller);
 extern DF1(jtfix);
@@ -148,12 +155,14 @@ extern DF2(jtkeybox);
 extern DF2(jtkeyheadtally);
 extern F1(jthalve);
 extern F1(jthash);
+extern F1(jthashfinal);
 extern F1(jthead);
 extern F1(jthexrep1);
 // extern F1(jthgdiff);
 extern DF1(jthost);
 extern DF1(jthostne);
 extern DF1(jticap);
+extern F1(jticapcompile);
 extern F1(jticvt);
 extern F1(jtiden);
 extern F1(jtidensb);
@@ -172,6 +181,7 @@ extern F1(jtisnan);
 extern F1(jtisempty);
 extern F1(jtisitems);
 extern F1(jtisnotempty);
+extern F1(jtixcreate);
 extern F1(jtjclose);
 extern F1(jtjdir);
 extern F1(jtjdot1);
@@ -218,6 +228,7 @@ extern F1(jtlocsizeq);
 extern F1(jtlocsizes);
 extern F1(jtlocswitch);
 // extern F1(jtlogar1);
+extern F1(jtlpsolve);
 extern F1(jtlrep);
 extern DF1(jtlrx1);
 extern DF2(jtlrx2);
@@ -292,6 +303,7 @@ extern DF1(jtprx);
 extern F1(jtqpctr);
 extern F1(jtqpfreq);
 extern DF1(jtqr);
+extern F1(jtrandist1);
 extern F1(jtranking);
 extern F1(jtrankle);
 extern F1(jtrat);
@@ -318,6 +330,8 @@ extern F1(jtrngstateq);
 extern F1(jtrngstates);
 extern F1(jtroll);
 extern F1(jtrollx);
+extern F1(jtrowgrade1);
+extern F1(jtrowindex1);
 extern F1(jtrtrim);
 extern F1(jtsb1);
 extern F1(jtsborder);
@@ -416,6 +430,7 @@ extern F1(jtvtrans);
 extern F1(jtwordil);
 extern DF1(jtwords);
 extern F1(jtxco1);
+extern F1(jtxxhash1);
 
 // extern F1(jttest1);
 
@@ -434,6 +449,9 @@ extern F2(jtatop);
 extern F2(jtauditpyx);
 extern F2(jtbase2);
 extern F2(jtbinrep2);
+extern DF2(jtbitcopy2);
+extern DF2(jtbitfrom2);
+extern DF2(jtbitunpack2);
 // extern F2(jtbit);
 // extern F2(jtbitmatch);
 extern DF2(jtbitwiserotate);
@@ -450,6 +468,7 @@ extern F2(jtcdproc2);
 extern F2(jtcolon);
 extern DF2(jtcombineeps);
 extern F2(jtcpufeature2);
+extern F2(jtcsvsplit2);
 extern F2(jtcrc2);
 extern DF2(jtcut2);
 extern F2(jtcut);
@@ -477,6 +496,7 @@ extern F2(jtexec2);
 extern F2(jtexpand);
 extern DF2(jtexpn2);
 extern F2(jtfc2);
+extern F2(jtfft2);
 extern DF2(jtfetch);
 extern F2(jtfit);
 extern F1(jtqfill);
@@ -504,6 +524,7 @@ extern F2(jtgemmtune2);
 // extern F2(jtgenbitwiseshifta);
 extern F2(jtgrade1p);
 extern F2(jtgrade2);
+extern F2(jthashupdate);
 extern F2(jthexrep2);
 extern F2(jthgeom);
 extern A jthook(J,A,A,A);
@@ -558,12 +579,14 @@ extern DF2(jtover);
 extern F2(jtpco2);
 extern DF2(jtpderiv2);
 extern F2(jtpdt);
+extern DF2(jtpdtbatch);
 extern F2(jtpdtsp);
 extern F2(jtpmarea2);
 extern DF2(jtpoly2);
 extern F2(jtqco2);
 extern F2(jtqhash12);
 extern F2(jtqq);
+extern F2(jtrandist2);
 extern F2(jtrdot2);
 extern F2(jtreaxis);
 extern F2(jtreitem);
@@ -575,6 +598,8 @@ extern F2(jtrezero);
 extern F2(jtright2);
 extern F2(jtroot);
 extern F2(jtrotate);
+extern F2(jtrowgrade2);
+extern F2(jtrowindex2);
 extern F2(jtsb2);
 extern F2(jtscapco);
 extern DF2(jtscm002);
@@ -616,6 +641,7 @@ extern DF2(jtxdefn);
 extern F2(jtxlog2a);
 extern F2(jtxroota);
 extern DF2(jtxrx);
+extern F2(jtxxhash2);
 
 extern F1(jtamend);
 extern DF1(jtbitwise1);
@@ -626,6 +652,7 @@ extern DF1(jtexppi);
 extern DF1(jtfsmfx);
 extern DF1(jthgcoeff);
 extern DF1(jthook1cell);
+extern DF1(jticapfixedleft);
 extern DF2(jthook2cell);
 extern DF1(jtmean);
 extern DF1(jtnum1);
@@ -717,6 +744,7 @@ extern DC       jtdeba(J,I,void*,void*,A);
 extern void     jtdebdisp(J,DC);
 extern void     jtdebz(J);
 extern A        jtdecorate(J,A,I);
+extern A        jtdetbatch(J,A);
 extern I        jtdeprecmsg(J,I,C*);
 extern A        jtdfss1(J,A,A,A);
 extern A        jtdfss2(J,A,A,A,A);
@@ -821,6 +849,8 @@ extern F1(jtshowinplacing1);
 extern F1(jtcheckcompfeatures);
 extern F2(jtshowinplacing2);
 extern B        jtlocdestroy(J,A);
+extern A        jtlublk(J,A,A*,I*);
+extern A        jtlusolve(J,A,A,A,I);
 extern I        jtmaxtype(J,I,I);
 extern B        jtmeminits(JS);
 extern B        jtmeminitt(J);
@@ -835,6 +865,7 @@ extern A        jtparsea(J,A*,I);
 extern A        jtparsex(J,A*,I,I,DC);
 extern A        jtpaxis(J,I,A);
 extern A        jtpcvt(J,I,A);
+extern A        jtpdtE(J,A,A,A,I,I,I);
 extern A        jtpee(J,A*,UI8,I,I,DC);
 extern A        jtpfill(J,I,A);
 extern A        jtpind(J,I,A);
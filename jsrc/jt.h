@@ -39,15 +39,15 @@ typedef struct rngparms {
 
 // should align this to cacheline bdy
 typedef struct rngdata {
- RNGPARMS rngparms[5];  // parms for RNGs when used singly
+ RNGPARMS rngparms[6];  // parms for RNGs when used singly
  UI*  rngv;             /* RNG: rngV[rng]                                  */
  UI*  rngfxsv;          /* RNG: rngv for fixed seed (?.)                   */
  A    rngseed;          /* RNG: array seed                                 */
  S    rngi;             // RNG: current index into state array
  C    rngw;             /* RNG: # bits in a random #                       */
  C    rng;              /* RNG: generator selector                         */
- RNGPARMS rngparms0[5];  // parms for RNG 0
- } RNG;  // 342 bytes
+ RNGPARMS rngparms0[6];  // parms for RNG 0
+ } RNG;  // 406 bytes
 
 #if PYXES || 1
 typedef struct jobstruct JOB;
@@ -3,3 +3,145 @@
 /*                                                                         */
 /* Verbs: Bit Type                                                         */
 
+
+#include "j.h"
+
+// A packed boolean list of length n is an INT list of 1+>.n%BW words: the first word is n, and item i is bit BW|i of word 1+<.i%BW.  The bits past n in the last word are 0.
+// Because the first word is the length, b. cannot combine packed lists; m 128!:27 is m b. for them, for the bitwise m of 16 b. to 31 b.:
+// 17 is *., 23 is +., 22 is ~:, 18 is x > y (x *. -. y), and the monad 26 is -.; all of them keep the unused bits 0.
+// 128!:20 y packs the boolean list y, and x 128!:20 y is x {. the booleans held in y (negative x takes from the end)
+// 128!:21 y is +/ of the packed list y, and x 128!:21 y is (unpacked x) # y
+// 128!:22 y is I. of the packed list y, and x 128!:22 y is x { unpacked y
+// 128!:27 is an adverb: m 128!:27 is m b. on packed lists, which must have the same length
+
+// pack the n booleans at b into bytes at z, 8 to a byte, least significant bit first.  The unused bits of the last byte are 0
+static void bitpack(UC *z,B *b,I n){I i=0;
+#if C_AVX2 || EMU_AVX2
+ for(;i+32<=n;i+=32){UI4 m=~(UI4)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(b+i)),_mm256_setzero_si256())); MC(z+(i>>LGBB),&m,4);}
+#endif
+ for(;i+BB<=n;i+=BB){UI8 t; MC(&t,b+i,BB);
+#if C_AVX2
+  z[i>>LGBB]=(UC)PEXT(t,0x0101010101010101);
+#else
+  z[i>>LGBB]=(UC)((t*0x0102040810204080ULL)>>56);  // each 0/1 byte lands in its own bit of the top byte, with no carries
+#endif
+ }
+ if(i<n){UC m=0; for(I j=n-1;j>=i;--j)m=(m<<1)|b[j]; z[i>>LGBB]=m;}
+}
+
+// unpack n booleans from bytes at p into z
+static void bitunpack(B *z,UC *p,I n){I i=0;
+ for(;i+BB<=n;i+=BB){UC m=p[i>>LGBB];
+#if C_AVX2
+  UI8 t=PDEP(m,0x0101010101010101); MC(z+i,&t,BB);
+#else
+  for(I j=0;j<BB;++j)z[i+j]=(m>>j)&1;
+#endif
+ }
+ for(;i<n;++i)z[i]=(p[i>>LGBB]>>(i&(BB-1)))&1;
+}
+
+#define BITWORDS(n) (((n)>>LGBW)+!!((n)&(BW-1)))  // number of words holding n bits
+// 1 if the bits of the packed list p of #w words past n are all 0
+static B bitunusedok(UI *p,I nw,I n){R !nw||!((p[nw-1]>>1)>>((n-1)&(BW-1)));}
+// audit a packed list w: an INT list (or a boolean one, as from 1 1) whose first word is the length, followed by that many bits.  Set n to the length, p to the bits, nw to the number of words of bits
+#define BITAUDIT(w,n,p,nw) ASSERT(AR(w)==1,EVRANK) ASSERT(AT(w)&B01+INT,EVDOMAIN) ASSERT(AN(w)>0,EVLENGTH) if(AT(w)&B01)RZ(w=cvt(INT,w)); \
+ n=IAV1(w)[0]; p=(UI*)IAV1(w)+1; nw=AN(w)-1; ASSERT(n>=0,EVDOMAIN) ASSERT(nw==BITWORDS(n),EVLENGTH) ASSERT(bitunusedok(p,nw,n),EVDOMAIN)
+
+DF1(jtbitpack1){A z;
+ F1RANK(1,jtbitpack1,self);
+ ASSERT(AR(w)<=1,EVRANK) ASSERT(AT(w)&B01||!AN(w),EVDOMAIN)
+ I n=AN(w), nw=BITWORDS(n);
+ GATV0(z,INT,1+nw,1); IAV1(z)[0]=n; if(nw){IAV1(z)[nw]=0; bitpack((UC*)(IAV1(z)+1),BAV(w),n);}  // clear the last word, which may be partly written
+ RETF(z);
+}
+
+DF2(jtbitunpack2){A z;I k,n,nw;UI *p;
+ F2RANK(0,1,jtbitunpack2,self);
+ ASSERT(!AR(a),EVRANK) RE(k=i0(a)); ASSERT(k!=IMIN,EVLIMIT) BITAUDIT(w,n,p,nw)
+ I m=ABS(k), t=MIN(m,n), s=k<0?n-t:0;  // result length, # booleans taken, and the first of them: negative x takes from the end
+ GATV0(z,B01,m,1); B *zv=BAV1(z)+(k<0?m-t:0); mvc(m-t,BAV1(z)+(k<0?0:t),1,MEMSET00);  // overtake fills with 0, at the front if x<0
+ I h=MIN(t,(-s)&(BB-1)); DO(h, zv[i]=(((UC*)p)[(s+i)>>LGBB]>>((s+i)&(BB-1)))&1;)  // bits before the first byte boundary
+ bitunpack(zv+h,(UC*)p+((s+h)>>LGBB),t-h);
+ RETF(z);
+}
+
+// number of 1s in the packed list at p
+static I bitcount(UI *p,I nw){I c=0; DO(nw, c+=__builtin_popcountll(p[i]);) R c;}
+
+DF1(jtbitcount1){I n,nw;UI *p;
+ F1RANK(1,jtbitcount1,self); BITAUDIT(w,n,p,nw)
+ R sc(bitcount(p,nw));
+}
+
+// I. of the packed list at p, into z
+static void bitindex(I *z,UI *p,I nw){
+ DO(nw, UI m=p[i]; I b=i<<LGBW; while(m){*z++=b+CTTZI(m); m&=m-1;})
+}
+
+DF1(jtbitindex1){A z;I n,nw;UI *p;
+ F1RANK(1,jtbitindex1,self); BITAUDIT(w,n,p,nw)
+ GATV0(z,INT,bitcount(p,nw),1); bitindex(IAV1(z),p,nw);
+ RETF(z);
+}
+
+// x 128!:21 y: the items of y selected by the packed mask x.  Direct types are copied a word of the mask at a time: a word of all 1s is one
+// move, a word of 0s is skipped, and the rest visit only the 1 bits.  1-byte items take 8 at a time with pext.  Other types go through {
+DF2(jtbitcopy2){A z;I n,nw;UI *p;
+ F2RANK(1,RMAX,jtbitcopy2,self); BITAUDIT(a,n,p,nw)
+ ASSERT(!ISSPARSE(AT(w)),EVNONCE) ASSERT(AR(w),EVRANK) ASSERT(n==AS(w)[0],EVLENGTH)
+ I zn=bitcount(p,nw);
+ if(!(AT(w)&DIRECT)){A x; GATV0(x,INT,zn,1); bitindex(IAV1(x),p,nw); R from(x,w);}
+ I c; PROD(c,AR(w)-1,AS(w)+1); I k=c<<bplg(AT(w));  // atoms and bytes per item
+ GA(z,AT(w),zn*c,AR(w),AS(w)); AS(z)[0]=zn; if(!zn)RETF(z);
+ C *wv=CAV(w), *zv=CAV(z), *ze=zv+zn*k;
+ DO(nw, UI m=p[i]; C *s=wv+(i<<LGBW)*k;
+  if(m==~(UI)0){MC(zv,s,k<<LGBW); zv+=k<<LGBW;}  // all of the word
+#if C_AVX2
+  else if(k==1&&(i+1)<<LGBW<=n){  // 1-byte items in a full word: expand each byte of the mask to a byte mask and extract the selected bytes
+   for(;m;m>>=BB,s+=BB){UI8 t,mb=PDEP(m&0xff,0x0101010101010101)*0xff; MC(&t,s,BB); t=PEXT(t,mb); I c=__builtin_popcountll(mb)>>LGBB;
+    if(zv+BB<=ze)MC(zv,&t,BB);else MC(zv,&t,c); zv+=c;}
+  }
+#endif
+  else if(k==SZI)while(m){*(I*)zv=((I*)s)[CTTZI(m)]; zv+=SZI; m&=m-1;}
+  else while(m){MC(zv,s+CTTZI(m)*k,k); zv+=k; m&=m-1;}
+ )
+ RETF(z);
+}
+
+// x 128!:22 y: x { unpacked y.  Negative indexes count from the end, as in {
+DF2(jtbitfrom2){A z;I n,nw;UI *p;
+ F2RANK(RMAX,1,jtbitfrom2,self); BITAUDIT(w,n,p,nw)
+ if(!(AT(a)&INT))RZ(a=cvt(INT,a));
+ UC *pb=(UC*)p; I *av=IAV(a);
+ GATV(z,B01,AN(a),AR(a),AS(a)); B *zv=BAV(z);
+ DO(AN(a), I j=av[i]; j+=REPSGN(j)&n; ASSERT((UI)j<(UI)n,EVINDEX) zv[i]=(pb[j>>LGBB]>>(j&(BB-1)))&1;)
+ RETF(z);
+}
+
+// result words of the function with truth table m (bit 3-(2*x+y) of m is the result for bits x and y) on the nw words at x and y, into z.  The unused bits of the last word are cleared
+static void bitlogic(UI *z,UI *x,UI *y,I nw,I n,I m){
+ UI m0=-(UI)((m>>3)&1), m1=-(UI)((m>>2)&1), m2=-(UI)((m>>1)&1), m3=-(UI)(m&1);  // masks for 0 0, 0 1, 1 0, 1 1
+ DO(nw, UI u=x[i], v=y[i]; z[i]=(~u&~v&m0)|(~u&v&m1)|(u&~v&m2)|(u&v&m3);)
+ if(n&(BW-1))z[nw-1]&=((UI)1<<(n&(BW-1)))-1;
+}
+
+// the verb m 128!:27, with m in h; a is 0 for the monad
+static A jtbitlogicxy(J jt,A a,A w,A self){A z;I n,nw,an,anw;UI *p,*ap;
+ BITAUDIT(w,n,p,nw) if(a){BITAUDIT(a,an,ap,anw) ASSERT(an==n,EVLENGTH)}else ap=0;
+ GATV0(z,INT,1+nw,1); IAV1(z)[0]=n;
+ if(!ap){GATV0(a,INT,nw,1); mvc(nw*SZI,IAV1(a),1,MEMSET00); ap=(UI*)IAV1(a);}  // the monad is 0 m b. y
+ bitlogic((UI*)IAV1(z)+1,ap,p,nw,n,IAV(FAV(self)->fgh[2])[0]);
+ RETF(z);
+}
+static DF1(jtbitlogic1){F1RANK(1,jtbitlogic1,self); R jtbitlogicxy(jt,0,w,self);}
+static DF2(jtbitlogic2){F2RANK(1,1,jtbitlogic2,self); R jtbitlogicxy(jt,a,w,self);}
+
+// m 128!:27: create the verb that applies m b. to packed lists
+F1(jtbitlogic){F1PREFIP;A z;I m;
+ ARGCHK1(w);
+ ASSERT(!AR(w),EVRANK) RE(m=i0(w)); ASSERT(BETWEENC(m,16,31),EVDOMAIN)
+ RZ(z=fdef(0,CIBEAM,VERB,jtbitlogic1,jtbitlogic2,0L,0L,sc(m),VASGSAFE,1,1,1));
+ FAV(z)->localuse.lu1.foreignmn[0]=128; FAV(z)->localuse.lu1.foreignmn[1]=27;  // display as the foreign
+ R z;
+}
@@ -4,6 +4,7 @@
 /* Verbs: Domino                                                           */
 
 #include "j.h"
+#include "gemm.h"
 
 static F1(jtnorm){R sqroot(pdt(w,conjug(w)));}
 
@@ -187,6 +188,210 @@ ARGCHK1(w);
  EPILOG(z);
 }
 
+
+// Native Householder QR on FL, for %. and 128!:0.  All matrices here are row-major; ld is the row stride.
+// A factored block holds R on and above the diagonal and the Householder vectors below it (with an implicit 1 on the diagonal);
+// tau[j] is the scale of reflector j, which is I - tau[j] v v'.  Blocks of QRNB reflectors are applied together as I - V T V'.
+// A tall matrix is reduced by TSQR: its rows are divided among the threads, and each thread keeps an R for its rows, stacking the next
+// block of rows under it and factoring the stack in cache.  The threads' Rs are then stacked and factored once more.  Right-hand sides are
+// carried as extra columns, so Q is never formed.  CMPX stays with the complex Householder above, which keeps exact zeros the real form would not.
+#define QRNB 16  // panel width
+
+// unblocked QR of the m x nf panel at a, applying each reflector only to the rest of the panel.  nf<=QRNB, nf<=m
+static void hqrpanel(D *a,I m,I nf,I ld,D *tau){
+ for(I c=0;c<nf;++c){D *d=a+c*ld+c; I mr=m-c;  // diagonal element, #rows from it down
+  D ss=0.0; for(I r=1;r<mr;++r)ss+=d[r*ld]*d[r*ld];
+  if(ss==0.0){tau[c]=0.0; continue;}  // nothing below the diagonal: H is I
+  D alpha=d[0]; D beta=-copysign(sqrt(alpha*alpha+ss),alpha);  // new diagonal, with sign opposite to alpha to avoid cancellation
+  tau[c]=(beta-alpha)/beta; D s=1.0/(alpha-beta); d[0]=beta;
+  for(I r=1;r<mr;++r)d[r*ld]*=s;
+  I nr=nf-c-1; if(nr==0)continue;
+  D w[QRNB]; DO(nr, w[i]=d[1+i];)  // w=v'A for the rest of the panel; v[0] is 1
+  for(I r=1;r<mr;++r){D v=d[r*ld]; D *row=d+r*ld+1; DO(nr, w[i]+=v*row[i];)}
+  DO(nr, w[i]*=tau[c]; d[1+i]-=w[i];)
+  for(I r=1;r<mr;++r){D v=d[r*ld]; D *row=d+r*ld+1; DO(nr, row[i]-=v*w[i];)}
+ }
+}
+
+// T (upper triangular, row stride QRNB) for the jb reflectors of the m-row panel at a.  T[0:j,j] = -tau[j] * T[0:j,0:j] * V[:,0:j]' v[j]
+static void hqrt(D *a,I m,I jb,I ld,D *tau,D *t){D g[QRNB*QRNB];
+ // g=V'V, the rows below the panel's triangle by dgemm, the triangle by hand
+ mvc(sizeof(g),g,1,MEMSET00); if(m>jb)dgemm_nn(jb,jb,m-jb,1.0,a+jb*ld,1,ld,a+jb*ld,ld,1,0.0,g,QRNB,1);  // dgemm scales C by beta, so C must not hold NaN
+ for(I r=1;r<jb;++r){D *row=a+r*ld; for(I j=0;j<r;++j){D v=row[j]; DO(j, g[i*QRNB+j]+=row[i]*v;)} DO(r, g[i*QRNB+r]+=row[i];)}  // row r of V is row[0:r], then 1, then 0s
+ DO(jb, I j=i; DO(j, I ii=i; D s=0.0; for(I k=ii;k<j;++k)s+=t[ii*QRNB+k]*g[k*QRNB+j]; t[ii*QRNB+j]=-tau[j]*s;) t[j*QRNB+j]=tau[j];)
+}
+
+// apply the block reflector of the jb reflectors of the m-row panel at a to the m x nc matrix at c: C=Q'C if trans, else C=QC.  w is jb x nc scratch
+static void hqrapply(D *a,I m,I jb,I ld,D *t,D *c,I nc,I ldc,D *w,I trans){
+ mvc(jb*nc*SZD,w,1,MEMSET00); if(m>jb)dgemm_nn(jb,nc,m-jb,1.0,a+jb*ld,1,ld,c+jb*ldc,ldc,1,0.0,w,nc,1);  // w=V'C
+ DO(jb, I r=i; D *cr=c+r*ldc; D *wr=w+r*nc; DO(nc, wr[i]+=cr[i];) for(I j=0;j<r;++j){D v=a[r*ld+j]; D *wj=w+j*nc; DO(nc, wj[i]+=v*cr[i];)})
+ if(trans){for(I i=jb-1;i>=0;--i){D *wi=w+i*nc; D tii=t[i*QRNB+i]; DO(nc, wi[i]*=tii;) for(I k=0;k<i;++k){D tk=t[k*QRNB+i]; D *wk=w+k*nc; DO(nc, wi[i]+=tk*wk[i];)}}}  // w=T'w, bottom up
+ else{for(I i=0;i<jb;++i){D *wi=w+i*nc; D tii=t[i*QRNB+i]; DO(nc, wi[i]*=tii;) for(I k=i+1;k<jb;++k){D tk=t[i*QRNB+k]; D *wk=w+k*nc; DO(nc, wi[i]+=tk*wk[i];)}}}  // w=Tw, top down
+ if(m>jb)dgemm_nn(m-jb,nc,jb,-1.0,a+jb*ld,ld,1,w,nc,1,1.0,c+jb*ldc,ldc,1);  // C-=Vw
+ DO(jb, I r=i; D *cr=c+r*ldc; DO(nc, cr[i]-=w[r*nc+i];) for(I j=0;j<r;++j){D v=a[r*ld+j]; D *wj=w+j*nc; DO(nc, cr[i]-=v*wj[i];)})
+}
+
+// blocked QR of the m x nc matrix at a: factor the first nf columns (nf<=m) and apply the reflectors to all nc.  scr has QRNB*QRNB+QRNB*nc
+static void hqr(D *a,I m,I nf,I nc,I ld,D *tau,D *scr){
+ for(I j=0;j<nf;j+=QRNB){I jb=MIN(QRNB,nf-j); D *p=a+j*ld+j;
+  hqrpanel(p,m-j,jb,ld,tau+j);
+  if(j+jb<nc){hqrt(p,m-j,jb,ld,tau+j,scr); hqrapply(p,m-j,jb,ld,scr,p+jb,nc-j-jb,ld,scr+QRNB*QRNB,1);}
+ }
+}
+
+typedef struct {
+ D *wv, *av;  // w and the right sides
+ I m, n, k;  // rows and columns of w, columns of the right sides
+ I ident;  // 1 if the right sides are the identity matrix (then k=m) rather than av
+ I nf, nc;  // columns to factor (n), and in all (n+k)
+ I rb;  // rows of w per block in TSQR
+ I rowspertask;
+ I bufsz;  // #D in the work area of each task
+ D *buf;  // work areas
+ D *pa, *pt, *pc; I pm, pjb, pnc, colspertask;  // the panel, T, and trailing columns of a parallel update
+} QRCTX;
+
+// copy rows r0 to r0+cnt-1 of the system [w,a] to d
+static void qrrows(QRCTX *c,I r0,I cnt,D *d){I n=c->n, k=c->k, nc=c->nc; D *w=c->wv+r0*n, *a=c->av+r0*k;
+ DO(cnt, MC(d,w,n*SZD); if(!c->ident){MC(d+n,a,k*SZD); a+=k;}else{mvc(k*SZD,d+n,1,MEMSET00); d[n+r0+i]=1.0;} w+=n; d+=nc;)
+}
+
+// TSQR task: reduce a range of rows to R, block by block
+static unsigned char jtqrx(J jt,void *ctx,UI4 ti){QRCTX *c=ctx;
+ I nf=c->nf, nc=c->nc; I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->m);
+ D *buf=c->buf+ti*c->bufsz, *tau=buf+(nf+c->rb)*nc, *scr=tau+nf;
+ mvc(nf*nc*SZD,buf,1,MEMSET00);  // the R of no rows
+ for(;b<e;b+=c->rb){I cnt=MIN(c->rb,e-b);
+  qrrows(c,b,cnt,buf+nf*nc);  // stack the next block under R
+  hqr(buf,nf+cnt,nf,nc,nc,tau,scr);
+  DO(nf, mvc(i*SZD,buf+i*nc,1,MEMSET00);)  // clear the reflectors from the lower triangle, leaving R
+ }
+ R 0;
+}
+
+// task to apply the block reflector to a range of the trailing columns
+static unsigned char jtqrapplyx(J jt,void *ctx,UI4 ti){QRCTX *c=ctx;
+ I c0=ti*c->colspertask, c1=MIN(c0+c->colspertask,c->pnc);
+ if(c0<c1)hqrapply(c->pa,c->pm,c->pjb,c->nc,c->pt,c->pc+c0,c1-c0,c->nc,c->buf+ti*QRNB*c->colspertask,1);
+ R 0;
+}
+
+#define QRMINAPPLY 65536  // TUNE don't split a trailing update smaller than this many multiplies
+// factor the first nf columns of the mr x nc matrix at a, with the trailing updates divided among the threads.  w has QRNB*(nc+nthreads)
+static void jtqrwhole(J jt,QRCTX *c,D *a,I mr,D *tau,D *t,D *w,I nthreads){I nf=c->nf, nc=c->nc;
+ for(I j=0;j<nf;j+=QRNB){I jb=MIN(QRNB,nf-j); D *p=a+j*nc+j; I ncr=nc-j-jb;
+  hqrpanel(p,mr-j,jb,nc,tau+j);
+  if(!ncr)continue;
+  hqrt(p,mr-j,jb,nc,tau+j,t);
+  I nt=MIN(nthreads,(ncr+QRNB-1)/QRNB); nt=(mr-j)*ncr*jb<QRMINAPPLY?1:nt;
+  if(nt>1){c->pa=p; c->pm=mr-j; c->pjb=jb; c->pt=t; c->pc=p+jb; c->pnc=ncr; c->colspertask=(ncr+nt-1)/nt; c->buf=w; jtjobrun(jt,jtqrapplyx,c,nt,0);}
+  else hqrapply(p,mr-j,jb,nc,t,p+jb,ncr,nc,w,1);
+ }
+}
+#undef QRMINAPPLY
+
+// R of the system [w,a]: w is an FL m x n (m>=n), a is an FL m x k, or the identity if ident.
+// Result has R, nf x nc, in its first nf rows of nc (below the diagonal is garbage)
+static A jtqrfactor(J jt,A w,A a,I k,I ident){A z;QRCTX c;
+ memset(&c,0,sizeof(c));
+ I m=AS(w)[0], n=AR(w)>1?AS(w)[1]:1;
+ c.wv=DAV(w); c.av=a?DAV(a):0; c.m=m; c.n=n; c.k=k; c.ident=ident; c.nf=n; c.nc=n+k;
+ I nf=c.nf, nc=c.nc; I scrsz=nf+QRNB*QRNB+QRNB*nc;  // tau, T, and w for hqrapply
+ c.rb=MAX(4*n,16*QRNB);  // rows of w per block.  The stack is at most 1/5 R
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(m<=2*c.rb){  // short: factor all the rows at once
+  GATV0(z,FL,m*nc+scrsz+QRNB*nthreads,1); D *buf=DAV(z), *tau=buf+m*nc;
+  qrrows(&c,0,m,buf);
+  jtqrwhole(jt,&c,buf,m,tau,tau+nf,tau+nf+QRNB*QRNB,nthreads);
+ }else{  // tall: TSQR
+  I ntasks=MIN(nthreads,m/c.rb); c.rowspertask=(m+ntasks-1)/ntasks;
+  c.bufsz=(nf+c.rb)*nc+scrsz;
+  GATV0(z,FL,ntasks*c.bufsz,1); c.buf=DAV(z);
+  if(ntasks>1)jtjobrun(jt,jtqrx,&c,ntasks,0);else jtqrx(jt,&c,0);
+  if(ntasks>1){A s;  // stack the Rs of the tasks and factor them
+   GATV0(s,FL,ntasks*nf*nc+scrsz+QRNB*nthreads,1); D *sv=DAV(s), *tau=sv+ntasks*nf*nc;
+   DO(ntasks, MC(sv+i*nf*nc,c.buf+i*c.bufsz,nf*nc*SZD);)
+   jtqrwhole(jt,&c,sv,ntasks*nf,tau,tau+nf,tau+nf+QRNB*QRNB,nthreads);
+   z=s;
+  }
+ }
+ R z;
+}
+
+// 1 if a %. w (monad if a is 0) can go through jtqrsolve: dense B01/INT/FL, w a nonempty list or table with at least as many rows as columns,
+// square if monad, and a with #w nonempty rows
+static I qrsolvable(A a,A w){
+ I t=AT(w)|(a?AT(a):0); if(t&~(B01+INT+FL)||!AN(w)||!BETWEENC(AR(w),1,2))R 0;
+ I m=AS(w)[0], n=AR(w)>1?AS(w)[1]:1; if(m<n)R 0;
+ if(!a)R AR(w)==2&&m==n;
+ R AR(a)&&AS(a)[0]==m&&AN(a);
+}
+
+// a %. w, or %. w if a is 0, by QR of w with a as the right sides.  *det is set to |det w| if w is a square B01/INT table, for icor
+static A jtqrsolve(J jt,A a,A w,D *det){A z,x;
+ *det=(AT(w)&B01+INT&&2==AR(w)&&AS(w)[0]==AS(w)[1])?1.0:0.0;
+ RZ(w=cvt(FL,w)) if(a)RZ(a=cvt(FL,a))
+ I m=AS(w)[0], n=AR(w)>1?AS(w)[1]:1, k=a?AN(a)/m:m, nf=n, nc=n+k;
+ RZ(x=jtqrfactor(jt,w,a,k,!a)); D *r=DAV(x);
+ D c=inf, d=0.0, determ=*det; DO(nf, D v=ABS(r[i*nc+i]); if(determ!=0){determ*=v; if(determ>1e20)determ=0.0;} c=MIN(c,v); d=MAX(d,v);)
+ ASSERT(c>d*FUZZ,EVDOMAIN) *det=determ;  // rank-deficient w
+ // back-substitute R x = Q'a, into the right-side columns of r
+ for(I i=nf-1;i>=0;--i){D *ri=r+i*nc, *xi=ri+nf; for(I j=i+1;j<nf;++j){D rij=ri[j]; D *xj=r+j*nc+nf; DO(k, xi[i]-=rij*xj[i];)} D rd=1.0/ri[i]; DO(k, xi[i]*=rd;)}
+ // result shape is (n if w is a table), }.$a
+ I zr=(AR(w)-1)+(a?AR(a)-1:1); GA00(z,FL,n*k,zr); I *zs=AS(z); if(AR(w)>1)*zs++=n; if(a)MCISH(zs,AS(a)+1,AR(a)-1)else *zs=m;
+ D *zv=DAV(z); DO(n, MC(zv+i*k,r+i*nc+nf,k*SZD);)
+ R z;
+}
+
+#define LUMINSOLVE 64  // TUNE smallest order of square w that %. solves by LU rather than QR
+// 1 if a %. w (monad if a is 0) can go through jtlusolvew: w a dense square B01/INT/FL/CMPX table of order at least LUMINSOLVE, a dense B01/INT/FL/CMPX with #w nonempty rows
+static I lusolvable(A a,A w){
+ I t=AT(w)|(a?AT(a):0); if(t&~(B01+INT+FL+CMPX)||AR(w)!=2||AS(w)[0]!=AS(w)[1]||AS(w)[0]<LUMINSOLVE)R 0;
+ R !a||(AR(a)&&AS(a)[0]==AS(w)[0]&&AN(a));
+}
+
+// a %. w, or %. w if a is 0, by the blocked LU of w (in vgauss.c), factoring once for all the right sides.  *det is as for jtqrsolve
+static A jtlusolvew(J jt,A a,A w,D *det){A lu,p,z;I sgn;
+ I t=(AT(w)|(a?AT(a):0))&CMPX?CMPX:FL; *det=AT(w)&B01+INT?1.0:0.0;
+ RZ(w=cvt(t,w)) if(a)RZ(a=cvt(t,a))
+ I n=AS(w)[0], k=a?AN(a)/n:n;
+ RZ(lu=jtlublk(jt,w,&p,&sgn));
+ D c=inf, d=0.0, determ=*det;
+ DO(n, D v=t&CMPX?hypot(ZAV(lu)[i*(n+1)].re,ZAV(lu)[i*(n+1)].im):ABS(DAV(lu)[i*(n+1)]); if(determ!=0){determ*=v; if(determ>1e20)determ=0.0;} c=MIN(c,v); d=MAX(d,v);)
+ ASSERT(c>d*FUZZ,EVDOMAIN) *det=determ;  // singular w
+ RZ(z=jtlusolve(jt,lu,p,a,k));
+ R reshape(a?shape(a):v2(n,n),z);  // result shape is n , }.$a
+}
+
+typedef struct {D *wv, *qv, *riv; I m, n, rowspertask;} QRQCTX;
+// task to form rows of Q=w R^-1
+static unsigned char jtqrqx(J jt,void *ctx,UI4 ti){QRQCTX *c=ctx; I n=c->n;
+ I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->m); if(b>=e)R 0;
+ mvc((e-b)*n*SZD,c->qv+b*n,1,MEMSET00); dgemm_nn(e-b,n,n,1.0,c->wv+b*n,n,1,c->riv,n,1,0.0,c->qv+b*n,n,1);
+ R 0;
+}
+
+#define QRQMINATOMS 4096  // TUNE don't start a task for fewer atoms of Q than this
+// 128!:0 on a nonempty FL table with at least as many rows as columns.  R is made with positive diagonal; Q is w R^-1
+static A jtqrfl(J jt,A w){A q,r,x;
+ I m=AS(w)[0], n=AS(w)[1];
+ RZ(x=jtqrfactor(jt,w,0,0,0)); D *xv=DAV(x);
+ GATV0(r,FL,n*n,2); AS(r)[0]=AS(r)[1]=n; D *rv=DAV2(r);
+ DO(n, I j=i; D *s=xv+j*n, *d=rv+j*n; D sgn=s[j]<0?-1.0:1.0; DO(j, d[i]=0.0;) for(I i=j;i<n;++i)d[i]=sgn*s[i];)  // upper triangle, rows with negative diagonal negated
+ D c=inf, d=0.0; DO(n, D v=rv[i*n+i]; c=MIN(c,v); d=MAX(d,v);) ASSERT(c>d*FUZZ,EVDOMAIN)
+ // R^-1 by back substitution, over the factorization in x
+ D *riv=xv; mvc(n*n*SZD,riv,1,MEMSET00);
+ for(I i=n-1;i>=0;--i){D *ri=rv+i*n, *xi=riv+i*n; xi[i]=1.0; for(I j=i+1;j<n;++j){D rij=ri[j]; D *xj=riv+j*n; for(I k=j;k<n;++k)xi[k]-=rij*xj[k];} D rd=1.0/ri[i]; for(I k=i;k<n;++k)xi[k]*=rd;}
+ GATV0(q,FL,m*n,2); AS(q)[0]=m; AS(q)[1]=n;
+ QRQCTX ctx={DAV(w),DAV2(q),riv,m,n,0};
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-m)&(1-nthreads)&(QRQMINATOMS-m*n))>=0)nthreads=1;  // if only one row, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,m); ctx.rowspertask=(m+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtqrqx,&ctx,nthreads,0);else jtqrqx(jt,&ctx,0);
+ AFLAGORLOCAL(r,AFUPPERTRI)
+ R jlink(q,r);
+}
+#undef QRQMINATOMS
 // qr (?) decomposition of w, returns q;r
 DF1(jtqr){A r,z;D c=inf,d=0,x;I n1,n,*s,wr;
  F1RANK(2,jtqr,self);
@@ -194,6 +399,7 @@ DF1(jtqr){A r,z;D c=inf,d=0,x;I n1,n,*s,wr;
  ASSERT(AT(w)&B01+INT+FL+CMPX+QP,EVDOMAIN);
  wr=AR(w); s=AS(w);
  ASSERT(2>wr||s[0]>=s[1],EVLENGTH);
+ if(2==wr&&AN(w)&&AT(w)&B01+INT+FL){RZ(w=cvt(FL,w)); R jtqrfl(jt,w);}  // real table: native QR
  RZ(z=qrr(w)); r=C(AAV(z)[1]); n=AS(r)[0]; n1=1+n;
  if(FL&AT(r)){D*v=DAV(r);  DQ(n, x= ABS(*v); if(x<c)c=x; if(x>d)d=x; v+=n1;);}
  else        {Z*v=ZAV(r);  DQ(n, x=zmag(*v); if(x<c)c=x; if(x>d)d=x; v+=n1;);}
@@ -232,7 +438,56 @@ static A jticor(J jt,A  w,D d){D *v;
  R w;
 }
 
+// %. on many small square real tables, as for %. on an array of rank > 2.  Each cell is inverted in a local area by Gauss-Jordan elimination with
+// partial pivoting; the cells are divided among the threads.  A B01/INT cell gets the integer correction, using the product of its pivots as |det|.
+// Result is mark if the cells are unsuitable or one is near-singular, leaving the cell-at-a-time path to give the result or the error
+typedef struct {
+ D *wv, *zv;  // argument and result cells
+ I n;  // order of each table
+ I ncells, cellspertask;
+ C icor;  // 1 if the argument was B01/INT
+ C bad;  // set if a cell was near-singular or gave NaN
+} MINVBCTX;
+
+#define MINVBMAX 16  // largest order handled here
+static unsigned char jtminvbx(J jt,void *ctx,UI4 ti){MINVBCTX *c=ctx; D t[MINVBMAX*MINVBMAX]; I n=c->n;
+ I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells);
+ for(I cell=b;cell<e;++cell){D *z=c->zv+cell*n*n;
+  MC(t,c->wv+cell*n*n,n*n*SZD); mvc(n*n*SZD,z,1,MEMSET00); DO(n, z[i*n+i]=1.0;)
+  D mn=inf, mx=0.0, determ=c->icor;
+  for(I p=0;p<n;++p){
+   I r=p; D piv=ABS(t[p*n+p]); for(I i=p+1;i<n;++i)if(ABS(t[i*n+p])>piv){piv=ABS(t[i*n+p]); r=i;}  // partial pivoting
+   if(r!=p)DO(n, D x=t[r*n+i]; t[r*n+i]=t[p*n+i]; t[p*n+i]=x; x=z[r*n+i]; z[r*n+i]=z[p*n+i]; z[p*n+i]=x;)
+   mn=MIN(mn,piv); mx=MAX(mx,piv); if(determ!=0){determ*=piv; if(determ>1e20)determ=0.0;}
+   if(piv==0.0)break;
+   D s=1.0/t[p*n+p]; DO(n, t[p*n+i]*=s; z[p*n+i]*=s;)
+   DO(n, D a=t[i*n+p]; if(i!=p&&a!=0.0){D *ti=t+i*n, *zi=z+i*n, *tp=t+p*n, *zp=z+p*n; DO(n, ti[i]-=a*tp[i]; zi[i]-=a*zp[i];)})
+  }
+  if(!(mn>mx*FUZZ)){c->bad=1; continue;}  // singular (or NaN)
+  if(determ!=0){D d=jround(determ), recipd=1/d; DO(n*n, z[i]=jround(d*z[i])*recipd;)}  // integer correction, as icor
+  DO(n*n, if(z[i]!=z[i])c->bad=1;)
+ }
+ R 0;
+}
+
+#define MINVBMINATOMS 4096  // TUNE don't start a task for fewer atoms than this
+static A jtminvbatch(J jt,A w){A z;I r=AR(w),*s=AS(w);
+ I n=s[r-1];
+ if(ISSPARSE(AT(w))||!(AT(w)&B01+INT+FL)||r<3||n!=s[r-2]||!BETWEENC(n,2,MINVBMAX)||!AN(w))R mark;
+ MINVBCTX c={0,0,n,AN(w)/(n*n),0,!!(AT(w)&B01+INT)};
+ RZ(w=cvt(FL,w)); c.wv=DAV(w);
+ GATV(z,FL,AN(w),r,s); c.zv=DAV(z);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(MINVBMINATOMS-AN(w)))>=0)nthreads=1;  // if only one cell, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,c.ncells); c.cellspertask=(c.ncells+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtminvbx,&c,nthreads,0);else jtminvbx(jt,&c,0);
+ R c.bad?mark:z;
+}
+#undef MINVBMAX
+#undef MINVBMINATOMS
+
 static A jtminvdet(J jt,A w,D *det){PROLOG(0068);A q,y,z;I m,n,*s,t,wr;
+ if(AR(w)>2){RZ(z=jtminvbatch(jt,w)); if(z!=mark){*det=0.0; EPILOG(z);}}  // many small real tables: all the inverses in one pass
  F1RANK(2,jtminv,DUMMYSELF);
  t=AT(w); wr=AR(w); s=AS(w); m=wr?s[0]:1; n=1<wr?s[1]:1;
  if(!wr){*det=0.0; R recip(w);}
@@ -247,7 +502,9 @@ static A jtminvdet(J jt,A w,D *det){PROLOG(0068);A q,y,z;I m,n,*s,t,wr;
  }else{
   // not RAT/XNUM.  Calculate inverse as R^-1 Q^-1 after taking QR decomp & using Q^-1=Q*
   *det=(t&B01+INT&&2==wr&&m==n)?1.0:0.0;  // if taking inverse of square int, allow setting up for correction afterward
-  z=jtlq(jt,w,det);
+  if(lusolvable(0,w))RZ(z=jtlusolvew(jt,0,w,det))  // large square: solve w x = I by LU
+  else if(qrsolvable(0,w))RZ(z=jtqrsolve(jt,0,w,det))  // square: solve w x = I by native QR
+  else z=jtlq(jt,w,det);
   z=icor(z,*det);  // if integer correction called for, do it
   z=2==wr?z:reshape(shape(w),z);
  }
@@ -294,6 +551,11 @@ DF2(jtmdiv){PROLOG(0069);A z;I t;
  t=AT(w);
  if(ISSPARSE(t))R mdivsp(a,w);
  D detv; // place to build determinant of inverse
+ if(lusolvable(a,w)||qrsolvable(a,w)){  // large square, or real: solve directly by LU or QR, with a as the right sides
+  RZ(z=lusolvable(a,w)?jtlusolvew(jt,a,w,&detv):jtqrsolve(jt,a,w,&detv));
+  if(AT(a)&B01+INT)z=icor(z,detv);
+  EPILOG(z);
+ }
  z=jtminvdet(jt,w,&detv);  // take generalized inverse of w, setting up for icor if needed
  z=pdt(2>AR(w)?reshape(shape(w),z):z,a);  // w^-1 mp a
  if(AT(a)&B01+INT)z=icor(z,detv);  // integer correct if a is not float (& correction is possible)
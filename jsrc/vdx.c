@@ -2,4 +2,71 @@
 /* Licensed use only. Any other use is in violation of copyright.          */
 /*                                                                         */
 /* Verbs: Extended Precision Floating Point                                */
-// not yet implemented
+
+#include "j.h"
+
+// +/ . * on QP.  Called from jtpdt once the arguments are QP and z has been allocated: a has m rows of p, w has p rows of n, z has m rows of n.
+// The columns of w are split into planes of high and low parts, padded with 0 to a multiple of NPAR, so that NPAR columns of a row of the result
+// are accumulated at once with the double-double multiply and add of ve.c.  The rows of the result are divided among the threads of threadpool 0.
+
+typedef struct {
+ E *av, *zv;  // a and the result
+ D *whi, *wlo;  // planes of w, each p rows of np
+ I m, n, p, np;
+ I rowspertask;
+} PDTECTX;
+
+static unsigned char jtpdtEx(J jt,void *ctx,UI4 ti){PDTECTX *c=ctx;
+ I n=c->n, p=c->p, np=c->np; I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->m);
+ for(I i=b;i<e;++i){E *arow=c->av+i*p, *zrow=c->zv+i*n;
+#if C_AVX2 || EMU_AVX2
+  __m256d sgnbit=_mm256_broadcast_sd((D*)&Iimin); __m256d mantmask=_mm256_broadcast_sd((D*)&(I){0x000fffffffffffff});  // masks for CANONE
+  I j=0;
+  // 2*NPAR columns at a time, to have two independent chains of adds
+  for(;j+2*NPAR<=np;j+=2*NPAR){__m256d x0,x1,y0,y1,z0=_mm256_setzero_pd(),z1=z0,u0=z0,u1=z0;
+   D *wh=c->whi+j, *wl=c->wlo+j;
+   DO(p, x0=_mm256_broadcast_sd(&arow[i].hi); x1=_mm256_broadcast_sd(&arow[i].lo);
+    MULTEE(x0,x1,_mm256_loadu_pd(wh),_mm256_loadu_pd(wl),y0,y1) PLUSEE(y0,y1,z0,z1,z0,z1)
+    MULTEE(x0,x1,_mm256_loadu_pd(wh+NPAR),_mm256_loadu_pd(wl+NPAR),y0,y1) PLUSEE(y0,y1,u0,u1,u0,u1)
+    wh+=np; wl+=np;)
+   CANONE(z0,z1) CANONE(u0,u1)
+   D h[2*NPAR],l[2*NPAR]; _mm256_storeu_pd(h,z0); _mm256_storeu_pd(l,z1); _mm256_storeu_pd(h+NPAR,u0); _mm256_storeu_pd(l+NPAR,u1);
+   DQ(MIN(2*NPAR,n-j), zrow[j+i].hi=h[i]; zrow[j+i].lo=l[i];)
+  }
+  if(j<np){__m256d x0,x1,y0,y1,z0=_mm256_setzero_pd(),z1=z0;  // last NPAR
+   D *wh=c->whi+j, *wl=c->wlo+j;
+   DO(p, x0=_mm256_broadcast_sd(&arow[i].hi); x1=_mm256_broadcast_sd(&arow[i].lo);
+    MULTEE(x0,x1,_mm256_loadu_pd(wh),_mm256_loadu_pd(wl),y0,y1) PLUSEE(y0,y1,z0,z1,z0,z1)
+    wh+=np; wl+=np;)
+   CANONE(z0,z1)
+   D h[NPAR],l[NPAR]; _mm256_storeu_pd(h,z0); _mm256_storeu_pd(l,z1);
+   DQ(n-j, zrow[j+i].hi=h[i]; zrow[j+i].lo=l[i];)
+  }
+#else
+  DO(n, I j=i; E t={0.,0.}; D *wh=c->whi+j, *wl=c->wlo+j;
+   DO(p, E y={*wh,*wl}; E u=TYMESE(arow[i],y); t=PLUSE(t,u); wh+=np; wl+=np;)
+   zrow[j]=t;)
+#endif
+ }
+ R 0;
+}
+
+#define PDTEMINPRODS 8192  // TUNE don't start a task for fewer multiplies than this
+// z=a +/ . * w for QP a and w.  a has m 1-cells of p, w has p items of n.  Result is z, or 0 if error
+A jtpdtE(J jt,A z,A a,A w,I m,I n,I p){A t;PDTECTX c;
+#if C_AVX2 || EMU_AVX2
+ I np=(n+NPAR-1)&-NPAR;
+#else
+ I np=n;
+#endif
+ GATV0(t,FL,2*p*np,1); D *whi=DAV(t), *wlo=whi+p*np;
+ E *wv=EAV(w); DO(p, D *h=whi+i*np, *l=wlo+i*np; DO(n, h[i]=wv->hi; l[i]=wv->lo; ++wv;) DP(np-n, h[np+i]=0.; l[np+i]=0.;))  // split w; zero the padding
+ c.av=EAV(a); c.zv=EAV(z); c.whi=whi; c.wlo=wlo; c.m=m; c.n=n; c.p=p; c.np=np;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-m)&(1-nthreads)&(PDTEMINPRODS-m*n*p))>=0)nthreads=1;  // if only one row, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,m); c.rowspertask=(m+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtpdtEx,&c,nthreads,0);else jtpdtEx(jt,&c,0);
+ E *zv=EAV(z); DO(m*n, ASSERT(!_isnan(zv[i].hi),EVNAN))  // 0*_ or _-_ somewhere
+ R z;
+}
+#undef PDTEMINPRODS
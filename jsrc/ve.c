@@ -241,6 +241,28 @@ AEXP(minusI4I4, I4,I4,I4,OFOPTEST(sub))
 AEXP(tymesI2I2, I2,I2,I2,OFOPTEST(mul))
 AEXP(tymesI4I4, I4,I4,I4,OFOPTEST(mul))
 
+// SP arithmetic stays in single precision, 8 atoms at a time.  zzop combines xx and yy; pfx does the same for the leftover atoms
+#if C_AVX2 || EMU_AVX2
+#define APFXDS(f,zzop,pfx,pref,suff) \
+ AHDR2(f,DS,DS,DS){DS u,v; pref \
+  if(n-1==0){I i=0; for(;i<m-7;i+=8){__m256 xx=_mm256_loadu_ps(x+i), yy=_mm256_loadu_ps(y+i); _mm256_storeu_ps(z+i,zzop);} for(;i<m;++i){u=x[i]; v=y[i]; z[i]=pfx(u,v);}} \
+  else if(n-1<0){n=~n; DQ(m, __m256 xx=_mm256_set1_ps(*x); u=*x++; I i=0; for(;i<n-7;i+=8){__m256 yy=_mm256_loadu_ps(y+i); _mm256_storeu_ps(z+i,zzop);} for(;i<n;++i){v=y[i]; z[i]=pfx(u,v);} y+=n; z+=n;)} \
+  else{DQ(m, __m256 yy=_mm256_set1_ps(*y); v=*y++; I i=0; for(;i<n-7;i+=8){__m256 xx=_mm256_loadu_ps(x+i); _mm256_storeu_ps(z+i,zzop);} for(;i<n;++i){u=x[i]; z[i]=pfx(u,v);} x+=n; z+=n;)} \
+  suff}
+#else
+#define APFXDS(f,zzop,pfx,pref,suff) APFX(f,DS,DS,DS,pfx,pref,suff)
+#endif
+APFXDS(plusDSDS,_mm256_add_ps(xx,yy),PLUS,NAN0;,R NANTEST?EVNAN:EVOK;)
+APFXDS(minusDSDS,_mm256_sub_ps(xx,yy),MINUS,NAN0;,R NANTEST?EVNAN:EVOK;)
+APFXDS(minDSDS,_mm256_min_ps(xx,yy),MIN,,R EVOK;)
+APFXDS(maxDSDS,_mm256_max_ps(xx,yy),MAX,,R EVOK;)
+// a NaN from a multiply can only be 0*_, which is 0
+APFXDS(tymesDSDS,_mm256_mul_ps(xx,yy),TYMES,I nz=m*(n<0?~n:n); DS *zsav=z; NAN0;,if(NANTEST){DO(nz, if(_isnan(zsav[i]))zsav[i]=0;)} R EVOK;)
+// a NaN from a divide may be 0%0, which is 0, or _%_, which is an error.  Redo a failing divide an atom at a time; that needs the arguments, so it cannot be inplace
+static APFXDS(divDSDS1,_mm256_div_ps(xx,yy),DIV,NAN0;,R NANTEST?EVNAN:EVOK;)
+static APFX(divDSDS0, DS,DS,DS, DIV,NAN0;,R NANTEST?EVNAN:EVOK;)
+AHDR2(divDSDS,DS,DS,DS){I rc=divDSDS1(n,m,x,y,z,jt); R rc==EVNAN?divDSDS0(n,m,x,y,z,jt):rc;}
+
 
 // II multiply, in double precision.  Always return error code so we can clean up
 AHDR2(tymesII,I,I,I){DPMULDECLS I u;I v;I *zi=z;   // could use a side channel to avoid having main loop look at rc
@@ -81,6 +81,7 @@ extern ADECLP(  pluspfxQ,Q, Q );                                    extern ADECL
 extern ADECLP(  pluspfxX,X, X );                                    extern ADECLS(  plussfxX,X, X );
 extern ADECLP(  pluspfxZ,Z, Z );  extern ADECLR(  plusinsZ,Z, Z );  extern ADECLS(  plussfxZ,Z, Z ); 
 extern ADECLR(  plusinsE,E, E );  extern ADECLR(  plusinsI2,I, I2 );   extern ADECLR(  plusinsI4,I, I4 );  
+extern ADECLR(  plusinsDS,DS, DS );  extern ADECLR( tymesinsDS,DS, DS );  extern ADECLR(  mininsDS,DS, DS );  extern ADECLR(  maxinsDS,DS, DS );
 extern ADECLR(  pluspfxI2,I, I2 );   extern ADECLR(  pluspfxI4,I, I4 );  
 extern ADECLR(  plussfxI2,I, I2 );   extern ADECLR(  plussfxI4,I, I4 );  
 extern ADECLP( tymespfxD,D, D );  extern ADECLR( tymesinsD,D, D );  extern ADECLS( tymessfxD,D, D );
@@ -334,6 +335,12 @@ extern ADECL2(tymesI2I2,I2,I2,I2);
 extern ADECL2(tymesI4I4,I4,I4,I4);
 extern ADECL2(remI2I2,I2,I2,I2);
 extern ADECL2(remI4I4,I4,I4,I4);
+extern ADECL2(plusDSDS,DS,DS,DS);
+extern ADECL2(minusDSDS,DS,DS,DS);
+extern ADECL2(minDSDS,DS,DS,DS);
+extern ADECL2(maxDSDS,DS,DS,DS);
+extern ADECL2(tymesDSDS,DS,DS,DS);
+extern ADECL2(divDSDS,DS,DS,DS);
 extern ADECL2( nandBB,void,void,void);
 extern ADECL2(   neAA,B,A,A);
 extern ADECL2(   neBB,void,void,void);
@@ -2,4 +2,137 @@
 /* Licensed use only. Any other use is in violation of copyright.          */
 /*                                                                         */
 /* Verbs: Fast Fourier Transform and Friends                               */
-// not implemented
\ No newline at end of file
+
+#include "j.h"
+
+// 128!:19 y is the discrete Fourier transform of each list in y, i. e. along the last axis: X[k] = +/ x[j] * ^ j. -2p1*j*k%n
+// x 128!:19 y is the same for x=1, and the inverse transform (with the 1/n scaling) for x=_1.  The result is complex with the shape of y.
+// A length that is a power of 2 uses an iterative radix-2 transform.  Any other length uses Bluestein's algorithm, which turns the transform
+// into a convolution done with power-of-2 transforms of length >: 2n-1.  Real lists of power-of-2 length are transformed as complex lists of half the length.
+// The plan (twiddle factors and the Bluestein filter) is built once per call and shared by all the lists, which are divided among the threads of threadpool 0.
+
+typedef struct {
+ I n;  // length of the transform
+ I m;  // length of the power-of-2 transform that does the work: n, n/2 for real input, or the Bluestein length
+ I real;  // 1 if the input is real and n is transformed as a complex list of n/2
+ Z *tw;  // m/2 twiddles, e^-2p1*k%m
+ Z *rw;  // for real input, n/2 twiddles e^-2p1*k%n used to unpack the half-length transform
+ Z *chirp;  // for Bluestein, n values of e^-1p1*k*k%n
+ Z *filt;  // for Bluestein, the transform of the conjugate chirp, length m
+ C *wv; I wk;  // input data and #bytes per list
+ Z *zv;  // result
+ I ncells, cellspertask;  // number of lists, number given to each task
+ Z *scratch;  // Bluestein work area, m for each task
+ I inv;  // 1 for inverse transform
+} FFTCTX;
+
+// complex multiply
+static INLINE Z zmul(Z a,Z b){Z z; z.re=a.re*b.re-a.im*b.im; z.im=a.re*b.im+a.im*b.re; R z;}
+
+// fill tw with the n twiddles e^-2p1*k%d.  Computed directly, not by recurrence, to keep full precision
+static void twiddles(Z *tw,I n,I d){DO(n, D a=(2*PI*i)/d; tw[i].re=cos(a); tw[i].im=-sin(a);)}
+
+// in-place forward transform of the m values at a, m a power of 2.  tw has the m/2 twiddles for m
+static void fftpow2(Z *a,I m,Z *tw){
+ // bit-reverse the order of the input
+ for(I i=1,j=0;i<m;++i){I bit=m>>1; for(;j&bit;bit>>=1)j^=bit; j^=bit; if(i<j){Z t=a[i]; a[i]=a[j]; a[j]=t;}}
+ // first stage: butterflies with twiddle 1
+ for(I s=0;s<m-1;s+=2){Z u=a[s], v=a[s+1]; a[s].re=u.re+v.re; a[s].im=u.im+v.im; a[s+1].re=u.re-v.re; a[s+1].im=u.im-v.im;}
+ for(I len=4;len<=m;len<<=1){I half=len>>1, step=m/len;
+  I k=0;
+#if C_AVX2 || EMU_AVX2
+  // 2 butterflies at a time.  a complex multiply is (v*w.re) addsub (swap(v)*w.im)
+  for(;k<half;k+=2){
+   __m256d w=_mm256_set_pd(tw[(k+1)*step].im,tw[(k+1)*step].re,tw[k*step].im,tw[k*step].re);
+   __m256d wre=_mm256_movedup_pd(w), wim=_mm256_permute_pd(w,0xf);
+   for(I s=k;s<m;s+=len){
+    __m256d u=_mm256_loadu_pd((D*)&a[s]), v=_mm256_loadu_pd((D*)&a[s+half]);
+    v=_mm256_addsub_pd(_mm256_mul_pd(v,wre),_mm256_mul_pd(_mm256_permute_pd(v,0x5),wim));
+    _mm256_storeu_pd((D*)&a[s],_mm256_add_pd(u,v)); _mm256_storeu_pd((D*)&a[s+half],_mm256_sub_pd(u,v));
+   }
+  }
+#endif
+  for(;k<half;++k){Z w=tw[k*step];
+   for(I s=k;s<m;s+=len){Z u=a[s], v=zmul(a[s+half],w); a[s].re=u.re+v.re; a[s].im=u.im+v.im; a[s+half].re=u.re-v.re; a[s+half].im=u.im-v.im;}
+  }
+ }
+}
+
+// transform one list, from wv to zv.  scr is Bluestein scratch
+static void fftcell(FFTCTX *c,C *wv,Z *zv,Z *scr){I n=c->n, m=c->m;
+ if(c->real){D *x=(D*)wv; I h=n>>1;
+  // pack the reals as h complex values, transform, and unpack: with Z the transform of the packed list, X[k] = E + W^k O and X[k+h] = E - W^k O,
+  // where E = (Z[k] + conj Z[h-k])/2 and O = -i(Z[k] - conj Z[h-k])/2.  k and h-k are done together so the unpacking can be in place
+  DO(h, zv[i].re=x[2*i]; zv[i].im=x[2*i+1];)
+  fftpow2(zv,h,c->tw);
+  for(I k=0;k<=h>>1;++k){I j=(h-k)&(h-1); Z zk=zv[k], zj=zv[j];
+   Z e, o, t;
+   e.re=0.5*(zk.re+zj.re); e.im=0.5*(zk.im-zj.im); o.re=0.5*(zk.im+zj.im); o.im=-0.5*(zk.re-zj.re);
+   t=zmul(o,c->rw[k]); zv[k].re=e.re+t.re; zv[k].im=e.im+t.im; zv[k+h].re=e.re-t.re; zv[k+h].im=e.im-t.im;
+   if(j!=k){  // the partner h-k, from the same two values
+    e.re=0.5*(zj.re+zk.re); e.im=0.5*(zj.im-zk.im); o.re=0.5*(zj.im+zk.im); o.im=-0.5*(zj.re-zk.re);
+    t=zmul(o,c->rw[j]); zv[j].re=e.re+t.re; zv[j].im=e.im+t.im; zv[j+h].re=e.re-t.re; zv[j+h].im=e.im-t.im;
+   }
+  }
+ }else if(c->chirp){Z *ch=c->chirp;
+  // Bluestein: X[k] = chirp[k] * (a conv filter)[k], where a[j] = x[j]*chirp[j], zero-padded to m
+  DO(n, scr[i]=zmul(((Z*)wv)[i],ch[i]);) mvc((m-n)*sizeof(Z),scr+n,1,MEMSET00);
+  fftpow2(scr,m,c->tw);
+  DO(m, Z t=zmul(scr[i],c->filt[i]); scr[i].re=t.re; scr[i].im=-t.im;)  // multiply by the filter; conjugate for the inverse transform
+  fftpow2(scr,m,c->tw);
+  D r=1.0/m; DO(n, Z t; t.re=scr[i].re*r; t.im=-scr[i].im*r; zv[i]=zmul(t,ch[i]);)
+ }else{
+  if((C*)zv!=wv)MC(zv,wv,n*sizeof(Z));
+  fftpow2(zv,n,c->tw);
+ }
+}
+
+static unsigned char jtfftx(J jt,void *ctx,UI4 ti){FFTCTX *c=ctx;
+ I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells); Z *scr=c->scratch?c->scratch+ti*c->m:0;  // each task has its own scratch
+ for(I i=b;i<e;++i){
+  Z *zv=c->zv+i*c->n;
+  if(c->inv&!c->real){C *t=c->wv+i*c->wk; DO(c->n, zv[i].re=((Z*)t)[i].re; zv[i].im=-((Z*)t)[i].im;) fftcell(c,(C*)zv,zv,scr);}  // inverse is conj(fft(conj x))
+  else fftcell(c,c->wv+i*c->wk,zv,scr);
+  if(c->inv){D r=1.0/c->n; DO(c->n, zv[i].re*=r; zv[i].im*=-r;)}
+ }
+ R 0;
+}
+
+#define FFTMINATOMS 4096  // TUNE don't start a task for fewer atoms than this
+static A jtfft(J jt,A w,I inv){A z,t;FFTCTX c;
+ ARGCHK1(w);
+ ASSERT(!ISSPARSE(AT(w)),EVNONCE) ASSERT(AT(w)&(B01+INT+FL+CMPX+XNUM+RAT+INT2+INT4)||!AN(w),EVDOMAIN)
+ I n=AR(w)?AS(w)[AR(w)-1]:1;
+ GATV(z,CMPX,AN(w),AR(w),AS(w)); if(!AN(w))R z;
+ if(!(AT(w)&CMPX))RZ(w=cvt(FL,w));
+ memset(&c,0,sizeof(c));
+ c.n=n; c.ncells=AN(w)/n; c.wv=CAV(w); c.zv=ZAV(z); c.inv=inv; c.wk=n<<bplg(AT(w));
+ I pow2=!(n&(n-1)); c.real=pow2&&n>=4&&AT(w)&FL;  // inverse of real x is conj(fft x)/n, so real input works in both directions
+ if(!c.real&&AT(w)&FL){RZ(w=cvt(CMPX,w)); c.wv=CAV(w); c.wk=n*sizeof(Z);}
+ I m=pow2?n>>c.real:(I)1<<(CTLZI(2*n-2)+1); c.m=m;  // length of the underlying power-of-2 transform
+ GATV0(t,CMPX,m/2+1,1); c.tw=ZAV(t); twiddles(c.tw,m/2,m);
+ if(c.real){GATV0(t,CMPX,n/2,1); c.rw=ZAV(t); twiddles(c.rw,n/2,n);}
+ if(!pow2){
+  // Bluestein plan: the chirp, and the transform of its conjugate, wrapped around to make a circular convolution of length m
+  GATV0(t,CMPX,n,1); c.chirp=ZAV(t);
+  DO(n, D a=(PI*(D)((i*i)%(2*n)))/n; c.chirp[i].re=cos(a); c.chirp[i].im=-sin(a);)  // reduce k*k mod 2n to keep the angle small
+  GATV0(t,CMPX,m,1); c.filt=ZAV(t); mvc(m*sizeof(Z),c.filt,1,MEMSET00);
+  DO(n, c.filt[i].re=c.chirp[i].re; c.filt[i].im=-c.chirp[i].im; if(i)c.filt[m-i]=c.filt[i];)
+  fftpow2(c.filt,m,c.tw);
+ }
+ // divide the lists among the threads
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(FFTMINATOMS-AN(w)))>=0)nthreads=1;  // if only one list, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,c.ncells); c.cellspertask=(c.ncells+nthreads-1)/nthreads;
+ if(c.chirp){GATV0(t,CMPX,nthreads*m,1); c.scratch=ZAV(t);}
+ if(nthreads>1)jtjobrun(jt,jtfftx,&c,nthreads,0);else jtfftx(jt,&c,0);
+ RETF(z);
+}
+#undef FFTMINATOMS
+
+F1(jtfft1){R jtfft(jt,w,0);}
+F2(jtfft2){I d;
+ ARGCHK2(a,w);
+ ASSERT(!AR(a),EVRANK) RE(d=i0(a)); ASSERT(d==1||d==-1,EVDOMAIN)
+ R jtfft(jt,w,d<0);
+}
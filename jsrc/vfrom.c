@@ -2123,3 +2123,157 @@ struct sprctx opctx={YC(rowsperthread)YC(ck)YC(bk)YC(m).ckthreshd=DAV(thresh)[0]
 #else
 F1(jtfindspr){ASSERT(0,EVNONCE);}
 #endif
+
+// 128!:23 general sparse linear program, solved by the revised simplex method
+//  y is Ap;Ai;Av;b;c[;parms]  for the problem  minimize c +/ . * x  subject to  b = A +/ . * x  and  x >: 0
+//   A is m by n, stored by columns: Ap is the n+1 column starts into Ai/Av, Ai the row# of each nonzero, Av its value.  Repeated rows in a column are added
+//   b is the m right-hand sides (any sign), c the n costs
+//   parms is maxiter,tolerance, either optional.  maxiter 0 (the default) means 20*(m+n)+100; tolerance defaults to 1e_9
+//  result is rc;objective;x  where rc is 0 (optimal), 1 (infeasible), 2 (unbounded), 3 (iteration limit; x is the last basic solution)
+// Phase 1 starts from an all-artificial basis and minimizes the sum of the artificials; phase 2 minimizes c.  The basis inverse is dense,
+// updated by a Gauss-Jordan pivot on each iteration and reinverted from the basis columns every so often to limit accumulated error.
+// Pricing is by most negative reduced cost, switching to Bland's rule after a run of degenerate pivots so that the method cannot cycle.
+// The simplex multipliers are updated from the pivot row, and computed afresh after each reinversion.
+// Like the 128!:9 kernels, the pricing (a sparse dot-product for each nonbasic column), the fresh multipliers, and the update of the inverse
+// are divided among the threads of threadpool 0; the whole loop runs here without returning to J.
+typedef struct {
+ I m, n;  // #rows, #columns
+ I *ap, *ai; D *av;  // A by columns, rows negated where b<0
+ D *binv;  // m by m basis inverse; row i goes with basis position i
+ D *cost;  // cost of each column, n real then m artificial
+ D *y;  // simplex multipliers
+ D *alpha;  // the entering column in terms of the basis
+ I *basis;  // column# in each basis position
+ C *inbasis;  // for each real column, 1 if it is basic
+ I r;  // pivot row
+ D tol;  // a reduced cost must be less than -tol to enter
+ C bland;  // 1 to take the first entering candidate rather than the best
+ C pass;  // 0=price, 1=multipliers, 2=update inverse
+ I ntasks;  // #tasks the current pass is divided into
+ I *bestj; D *bestd;  // per-task result of pricing
+} LPCTX;
+
+static unsigned char jtlpsolvex(J jt,void *ctx,UI4 ti){LPCTX *c=ctx; I m=c->m;
+ if(c->pass==0){  // price the columns in this task's range
+  I per=(c->n+c->ntasks-1)/c->ntasks, b=ti*per, e=MIN(b+per,c->n); I bj=-1; D bd=-c->tol;
+  for(I j=b;j<e;++j){if(c->inbasis[j])continue;
+   D d=c->cost[j]; for(I k=c->ap[j];k<c->ap[j+1];++k)d-=c->y[c->ai[k]]*c->av[k];
+   if(d<bd){bj=j; bd=d; if(c->bland)break;}
+  }
+  c->bestj[ti]=bj; c->bestd[ti]=bd;
+ }else if(c->pass==1){  // y = cB +/ . * binv, for the columns of binv in this task's range
+  I per=(m+c->ntasks-1)/c->ntasks, b=ti*per, e=MIN(b+per,m); D *y=c->y;
+  for(I j=b;j<e;++j)y[j]=0.0;
+  for(I i=0;i<m;++i){D cb=c->cost[c->basis[i]]; if(cb!=0.0){D *bv=c->binv+i*m; for(I j=b;j<e;++j)y[j]+=cb*bv[j];}}
+ }else{  // eliminate alpha from the rows in this task's range.  The pivot row has already been scaled
+  I per=(m+c->ntasks-1)/c->ntasks, b=ti*per, e=MIN(b+per,m); D *pr=c->binv+c->r*m;
+  for(I i=b;i<e;++i){D a=c->alpha[i]; if(i==c->r||a==0.0)continue; D *row=c->binv+i*m; for(I j=0;j<m;++j)row[j]-=a*pr[j];}
+ }
+ R 0;
+}
+
+#define LPMINATOMS 20000  // TUNE don't start tasks for a pass with fewer multiply-adds than this
+// run one pass, threaded if there is enough work.  Result is the number of tasks
+static I jtlprun(J jt,LPCTX *c,I pass,I work,I nthreads){
+ c->pass=pass; c->ntasks=((1-nthreads)&(LPMINATOMS-work))>=0?1:nthreads;
+ if(c->ntasks>1)jtjobrun(jt,jtlpsolvex,c,c->ntasks,0);else jtlpsolvex(jt,c,0);
+ R c->ntasks;
+}
+#undef LPMINATOMS
+
+// reinvert the basis into c->binv, using the m*m areas w and v.  Result is 0 if the basis is numerically singular, in which case binv is unchanged
+static I lpinvert(LPCTX *c,D *w,D *v){I m=c->m;
+ mvc(m*m*sizeof(D),w,1,MEMSET00); mvc(m*m*sizeof(D),v,1,MEMSET00);
+ DO(m, v[i*m+i]=1.0; I j=c->basis[i]; if(j<c->n){for(I k=c->ap[j];k<c->ap[j+1];++k)w[c->ai[k]*m+i]+=c->av[k];}else w[(j-c->n)*m+i]=1.0;)
+ for(I p=0;p<m;++p){  // Gauss-Jordan with partial pivoting on [w|v]
+  I r=p; D mx=ABS(w[p*m+p]); for(I i=p+1;i<m;++i)if(ABS(w[i*m+p])>mx){mx=ABS(w[i*m+p]); r=i;}
+  if(mx<1e-12)R 0;
+  if(r!=p)DO(m, D t=w[r*m+i]; w[r*m+i]=w[p*m+i]; w[p*m+i]=t; t=v[r*m+i]; v[r*m+i]=v[p*m+i]; v[p*m+i]=t;)
+  D s=1.0/w[p*m+p]; DO(m, w[p*m+i]*=s; v[p*m+i]*=s;)
+  for(I i=0;i<m;++i){D a=w[i*m+p]; if(i==p||a==0.0)continue; for(I j=p;j<m;++j)w[i*m+j]-=a*w[p*m+j]; for(I j=0;j<m;++j)v[i*m+j]-=a*v[p*m+j];}
+ }
+ MC(c->binv,v,m*m*sizeof(D)); R 1;
+}
+
+// bring column q into the basis at row r: alpha must hold the column in terms of the basis.  xb is updated with the step xb[r]%alpha[r]
+static void jtlppivot(J jt,LPCTX *c,D *xb,I q,I r,I nthreads){I m=c->m; D *a=c->alpha;
+ D theta=xb[r]/a[r]; DO(m, xb[i]-=theta*a[i];) xb[r]=theta;
+ D s=1.0/a[r]; D *pr=c->binv+r*m; DO(m, pr[i]*=s;)
+ c->r=r; jtlprun(jt,c,2,m*m,nthreads);
+ if(c->basis[r]<c->n)c->inbasis[c->basis[r]]=0; c->basis[r]=q; c->inbasis[q]=1;
+}
+
+// alpha = binv +/ . * column q
+static void lpftran(LPCTX *c,I q){I m=c->m; D *a=c->alpha;
+ DO(m, a[i]=0.0;)
+ for(I k=c->ap[q];k<c->ap[q+1];++k){D v=c->av[k]; D *bc=c->binv+c->ai[k]; DO(m, a[i]+=bc[i*m]*v;)}
+}
+
+#define LPDEGEN 50  // number of degenerate pivots in a row before switching to Bland's rule
+F1(jtlpsolve){A t;LPCTX c;
+ ARGCHK1(w);
+ ASSERT(AT(w)&BOX,EVDOMAIN) ASSERT(AR(w)==1,EVRANK) ASSERT(BETWEENC(AN(w),5,6),EVLENGTH)
+ A ap=C(AAV(w)[0]), ai=C(AAV(w)[1]), av=C(AAV(w)[2]), b=C(AAV(w)[3]), cc=C(AAV(w)[4]);
+ ASSERT(AR(ap)==1&&AR(ai)==1&&AR(av)==1&&AR(b)==1&&AR(cc)==1,EVRANK)
+ ASSERT(!ISSPARSE(AT(ap)|AT(ai)|AT(av)|AT(b)|AT(cc)),EVNONCE)
+ ASSERT((AT(ai)&(B01+INT)||!AN(ai))&&(AT(ap)&(B01+INT)),EVDOMAIN)
+ ASSERT((AT(av)&(B01+INT+FL)||!AN(av))&&(AT(b)&(B01+INT+FL)||!AN(b))&&(AT(cc)&(B01+INT+FL)||!AN(cc)),EVDOMAIN)
+ RZ(ap=cvt(INT,ap)); RZ(ai=cvt(INT,ai)); RZ(av=cvt(FL,av)); RZ(b=cvt(FL,b)); RZ(cc=cvt(FL,cc));
+ I m=AN(b), n=AN(cc), nz=AN(ai); I *apv=IAV(ap), *aiv=IAV(ai);
+ ASSERT(AN(ap)==n+1,EVLENGTH) ASSERT(AN(av)==nz,EVLENGTH)
+ ASSERT(apv[0]==0&&apv[n]==nz,EVINDEX) DO(n, ASSERT(apv[i]<=apv[i+1],EVINDEX)) DO(nz, ASSERT((UI)aiv[i]<(UI)m,EVINDEX))
+ I maxiter=0; D tol=1e-9;
+ if(AN(w)>5){A p=C(AAV(w)[5]); ASSERT(AR(p)<=1,EVRANK) ASSERT(AN(p)<=2,EVLENGTH) ASSERT(AT(p)&(B01+INT+FL)||!AN(p),EVDOMAIN) RZ(p=cvt(FL,p));
+  if(AN(p)>0){ASSERT(DAV(p)[0]>=0&&DAV(p)[0]<IMAX,EVDOMAIN) maxiter=(I)DAV(p)[0];} if(AN(p)>1){tol=DAV(p)[1]; ASSERT(tol>=0,EVDOMAIN)}}
+ if(maxiter==0)maxiter=20*(m+n)+100;
+ D *bv=DAV(b), *cv=DAV(cc); D bmax=0.0; DO(m, bmax=MAX(bmax,ABS(bv[i]));) DO(nz, ASSERT(!_isnan(DAV(av)[i]),EVNAN)) DO(m, ASSERT(!_isnan(bv[i]),EVNAN)) DO(n, ASSERT(!_isnan(cv[i]),EVNAN))
+
+ // copy A with the rows negated where b<0, so that the artificials give a feasible starting basis
+ memset(&c,0,sizeof(c)); c.m=m; c.n=n; c.ap=apv; c.ai=aiv; c.tol=tol;
+ GATV0(t,FL,nz,1); c.av=DAV(t); DO(nz, c.av[i]=bv[aiv[i]]<0?-DAV(av)[i]:DAV(av)[i];)
+ I mm; DPMULDE(m,m,mm);
+ GATV0(t,FL,mm,1); c.binv=DAV(t); mvc(mm*sizeof(D),c.binv,1,MEMSET00); DO(m, c.binv[i*m+i]=1.0;)
+ GATV0(t,FL,mm,1); D *w0=DAV(t); GATV0(t,FL,mm,1); D *w1=DAV(t);  // reinversion work areas
+ GATV0(t,FL,n+m,1); c.cost=DAV(t); DO(n, c.cost[i]=0.0;) DO(m, c.cost[n+i]=1.0;)  // phase 1 costs
+ GATV0(t,FL,m,1); c.y=DAV(t); GATV0(t,FL,m,1); c.alpha=DAV(t);
+ GATV0(t,FL,m,1); D *xb=DAV(t); DO(m, xb[i]=ABS(bv[i]);)
+ GATV0(t,INT,m,1); c.basis=IAV(t); DO(m, c.basis[i]=n+i;)
+ GATV0(t,LIT,n,1); c.inbasis=CAV(t); mvc(n,c.inbasis,1,MEMSET00);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1; nthreads=MAX(1,MIN(nthreads,MAX(n,m)));
+ GATV0(t,INT,nthreads,1); c.bestj=IAV(t); GATV0(t,FL,nthreads,1); c.bestd=DAV(t);
+
+ I phase=1, iter=0, degen=0, sincerefac=0, refac=MAX(100,m), rc=3, needy=1;
+ while(iter<maxiter){
+  JBREAK0;
+  if(needy){jtlprun(jt,&c,1,mm,nthreads); needy=0;}  // multipliers from scratch for new costs or a new inverse
+  c.bland=degen>LPDEGEN; I nt=jtlprun(jt,&c,0,nz+n,nthreads);  // price
+  I q=-1; D qd=0.0; DO(nt, I j=c.bestj[i]; if(j>=0&&(q<0||(c.bland?j<q:c.bestd[i]<qd))){q=j; qd=c.bestd[i];})
+  if(q<0){  // no improving column: the phase is finished
+   if(phase==2){rc=0; break;}
+   D infeas=0.0; DO(m, if(c.basis[i]>=n)infeas+=xb[i];)
+   if(infeas>100*tol*(1.0+bmax)){rc=1; break;}
+   // feasible.  Pivot out any artificials left at level 0 where a real column can replace them; the others are on redundant rows and stay at 0
+   DO(m, I r=i; if(c.basis[r]>=n){D *br=c.binv+r*m;
+    for(I j=0;j<n;++j){if(c.inbasis[j])continue; D v=0.0; for(I k=apv[j];k<apv[j+1];++k)v+=br[aiv[k]]*c.av[k];
+     if(ABS(v)>1e3*tol){lpftran(&c,j); jtlppivot(jt,&c,xb,j,r,nthreads); break;}}})
+   DO(n, c.cost[i]=cv[i];) DO(m, c.cost[n+i]=0.0;)
+   phase=2; degen=0; needy=1; continue;
+  }
+  lpftran(&c,q);
+  // ratio test: the basic variable that reaches 0 first leaves.  Ties go to the larger pivot, or under Bland's rule to the lower column#
+  I r=-1; D theta=inf;
+  DO(m, D a=c.alpha[i]; if(a>tol){D s=MAX(xb[i],0.0)/a;
+   if(s<theta||(s==theta&&(c.bland?c.basis[i]<c.basis[r]:a>c.alpha[r]))){r=i; theta=s;}})
+  if(r<0){rc=2; break;}  // unbounded
+  degen=theta<=tol?degen+1:0;
+  jtlppivot(jt,&c,xb,q,r,nthreads); ++iter;
+  D *br=c.binv+r*m; DO(m, c.y[i]+=qd*br[i];)  // the entering column's reduced cost goes to 0: y is updated by qd times the new pivot row
+  if(++sincerefac>=refac){sincerefac=0; if(lpinvert(&c,w0,w1)){DO(m, D s=0.0; br=c.binv+i*m; DO(m, s+=br[i]*ABS(bv[i]);) xb[i]=s;) needy=1;}}
+ }
+
+ // the solution and its objective
+ A x; GATV0(x,FL,n,1); D *xv=DAV(x); DO(n, xv[i]=0.0;) DO(m, if(c.basis[i]<n)xv[c.basis[i]]=MAX(xb[i],0.0);)
+ D obj=0.0; DO(n, obj+=cv[i]*xv[i];)
+ R jlink(sc(rc),jlink(scf(obj),box(x)));
+}
+#undef LPDEGEN
@@ -799,3 +799,55 @@ F2(jtordstati){A t;I n,wt;
  else     {I p=AV(t)[0],*v= AV(w); DO(n, if(p==*v++){j=i; break;});}
  R sc(j);
 }    /* a {/:w */
+
+// Tables held as a boxed list of columns, each column an array with one item per row.
+// These work on the columns directly, so rows are never boxed or assembled.  The results are ordinary INT lists (a grade, row numbers),
+// which p&{&.> applies to every column and /. takes as keys, so no row or table type is needed to carry them.
+// audit the table w and set *nr to the number of rows.  Result is 0 if error
+static A jttblaudit(J jt,A w,I *nr){I n=0;
+ ARGCHK1(w);
+ ASSERT(AT(w)&BOX||!AN(w),EVDOMAIN) ASSERT(AR(w)<=1,EVRANK)
+ A *wv=AAV(w); if(AN(w))SETIC(C(wv[0]),n);
+ DO(AN(w), I m; SETIC(C(wv[i]),m); ASSERT(m==n,EVLENGTH))
+ *nr=n; R w;
+}
+
+// 128!:15 y  grade of the rows of table y, i. e. /: of the table without building it.  x 128!:15 y is the same with x a boolean per column, 1 to sort that column descending
+// Columns are graded stably from last to first, each applied to the order produced so far
+static A jttblgrade(J jt,A a,A w){PROLOG(0000);A p,z;I nr;
+ RZ(jttblaudit(jt,w,&nr)); A *wv=AAV(w); I nc=AN(w);
+ if(!nc)R IX(nr);
+ B *av=a?BAV(a):0;
+ RZ(p=(av&&av[nc-1]?jtdgrade1:jtgrade1)(jt,C(wv[nc-1])));  // order by the last column
+ DQ(nc-1, RZ(z=from(p,C(wv[i]))); RZ(z=(av&&av[i]?jtdgrade1:jtgrade1)(jt,z)); RZ(p=from(z,p));)  // p{~/:p{column
+ EPILOG(p);
+}
+F1(jtrowgrade1){R jttblgrade(jt,0,w);}
+F2(jtrowgrade2){
+ ARGCHK2(a,w);
+ RZ(a=cvt(B01,a)); ASSERT(AR(a)<=1,EVRANK) ASSERT(AN(a)==AN(w),EVLENGTH)
+ R jttblgrade(jt,a,w);
+}
+
+// 128!:16 y  i.~ on the rows of table y.  x 128!:16 y is x i. y on rows, with tables x and y having the same number of columns
+// Each column is classified by i. and the class numbers are combined, a column at a time, into a class number for the row.
+// A row of y with a value not found in x gets a class of its own.  The monad is usable as the keys of /.
+static A jttblindex(J jt,A a,A w){PROLOG(0000);A c,k=0,t,u;I na,nw;
+ RZ(jttblaudit(jt,w,&nw));
+ if(a){RZ(jttblaudit(jt,a,&na)); ASSERT(AN(a)==AN(w),EVLENGTH)}else{a=w; na=nw; nw=0;}
+ A *av=AAV(a), *wv=AAV(w); I nc=AN(a);
+ I n=na+nw, nn; DPMULDE(n,n,nn);  // class numbers of two columns are combined as k*n+c
+ if(!nc)R reshape(sc(a==w?na:nw),sc(0));  // no columns: all rows match
+ DQ(nc, A x=C(av[i]);
+  RZ(t=indexof(x,x));  // classes for rows of x
+  GATV0(c,INT,n,1); I *cv=IAV1(c); MC(cv,IAV(t),na*SZI);
+  if(nw){A y=C(wv[i]);  // classes for rows of y; not found is unique.  Items of different rank never match
+   if(AR(y)==AR(x)){RZ(u=indexof(x,y)); I *uv=IAV(u); DO(nw, cv[na+i]=uv[i]<na?uv[i]:na+i;)}else DO(nw, cv[na+i]=na+i;)}
+  if(k){I *kv=IAV(k); DO(n, cv[i]+=kv[i]*n;) RZ(c=indexof(c,c));}  // combine with the previous columns and renumber
+  k=c;
+ )
+ if(nw){GATV0(t,INT,nw,1); I *tv=IAV1(t), *kv=IAV(k)+na; DO(nw, tv[i]=MIN(kv[i],na);) k=t;}  // index of first match in x, or #x
+ EPILOG(k);
+}
+F1(jtrowindex1){R jttblindex(jt,0,w);}
+F2(jtrowindex2){R jttblindex(jt,a,w);}
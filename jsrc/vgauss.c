@@ -4,6 +4,7 @@
 /* Verbs: Gaussian Elimination                                             */
 
 #include "j.h"
+#include "gemm.h"
 
 extern A jtthq1(J jt, Q y);
 // w is a rational matrix
@@ -57,26 +58,64 @@ static F1(jtdetr){A z;I c,e,g=1,i,j,k,r,*s;Q d,p,*u,*v,*x;
  GAT0(z,RAT,1,0); QAV(z)[0]=d; R z;
 }    /* determinant on rational matrix; works in place */
 
-static F1(jtdetd){D g,h,p,q,*u,*v,*x,*y,z=1.0;I c,d,e,i,j,k,r,*s;
- ARGCHK1(w);
- s=AS(w); r=s[0]; c=s[1]; v=DAV(w);
- NAN0;
+// determinant of the r by r real matrix at v, with row length c, by elimination with complete pivoting; works in place.  Result is 0 if a pivot was infinite
+static I detdv(D *v,I r,I c,D *zz){D g,h,p,q,*u,*x,*y,z=1.0;I d,e,i,j,k;
  for(j=0;j<r;++j){
   x=v+c*j; u=x+j; h=0.0; 
   DO(r-j, k=i; DO(c-j, g=ABS(*u); if(h<g){h=g; d=j+k; e=j+i;} ++u;); u+=j;);  /* find pivot, maximum abs element */
-  if(h==inf)R mark;
-  if(0==h)R scf(0.0);
+  if(h==inf)R 0;
+  if(0==h){*zz=0.0; R 1;}
   if(j!=d){u=v+c*d+j; y=x+j; DQ(c-j, q=*u; *u=*y; *y=q; ++u;  ++y; ); z=-z;}  /* interchange rows j and d */
   if(j!=e){u=x+e;     y=x+j; DQ(r-j, q=*u; *u=*y; *y=q; u+=c; y+=c;); z=-z;}  /* interchange cols j and e */
-  q=x[j]; z*=q; JBREAK0;
+  q=x[j]; z*=q;
   for(i=j+1;i<r;++i){
    u=v+c*i;
    if(u[j]){p=u[j]/q; for(k=j+1;k<r;++k)u[k]-=p*x[k];}
  }}
+ *zz=z; R 1;
+}
+
+static F1(jtdetd){D z;I *s;
+ ARGCHK1(w);
+ s=AS(w);
+ NAN0;
+ if(!detdv(DAV(w),s[0],s[1],&z))R mark;
  NAN1;
  R scf(z);
 }    /* determinant on real     matrix; works in place */
 
+// determinants of many small real matrices, as for -/ . * on an array of tables.  The cells are divided among the threads, each cell copied to
+// a local area and reduced by detdv, so the result is what detd gives cell by cell.  Result is mark if the cells are unsuitable or a pivot was infinite
+typedef struct {
+ D *wv, *zv;  // argument cells and result atoms
+ I n;  // order of each matrix
+ I ncells, cellspertask;
+ C bad;  // set if a cell could not be reduced
+} DETBCTX;
+
+#define DETBMAX 16  // largest order handled here
+static unsigned char jtdetbx(J jt,void *ctx,UI4 ti){DETBCTX *c=ctx; D t[DETBMAX*DETBMAX]; I n=c->n;
+ I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells);
+ for(I i=b;i<e;++i){MC(t,c->wv+i*n*n,n*n*sizeof(D)); if(!detdv(t,n,n,&c->zv[i]))c->bad=1; if(c->zv[i]!=c->zv[i])c->bad=1;}  // NaN is reported by the cell-at-a-time path
+ R 0;
+}
+
+#define DETBMINATOMS 4096  // TUNE don't start a task for fewer atoms than this
+A jtdetbatch(J jt,A w){A z;I r=AR(w),*s=AS(w);
+ I n=s[r-1];
+ if(ISSPARSE(AT(w))||!(AT(w)&B01+INT+FL)||r<3||n!=s[r-2]||!BETWEENC(n,3,DETBMAX)||!AN(w))R mark;
+ RZ(w=cvt(FL,w));
+ DETBCTX c={DAV(w),0,n,AN(w)/(n*n)};
+ GATV(z,FL,c.ncells,r-2,s); c.zv=DAV(z);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(DETBMINATOMS-AN(w)))>=0)nthreads=1;  // if only one cell, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,c.ncells); c.cellspertask=(c.ncells+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtdetbx,&c,nthreads,0);else jtdetbx(jt,&c,0);
+ R c.bad?mark:z;
+}
+#undef DETBMAX
+#undef DETBMINATOMS
+
 #define ZABT(v)         ((v).re*(v).re+(v).im*(v).im)
 
 static F1(jtdetz){A t;D g,h;I c,d,e,i,j,k,r,*s;Z p,q,*u,*v,*x,*y,z;
@@ -100,6 +139,131 @@ static F1(jtdetz){A t;D g,h;I c,d,e,i,j,k,r,*s;Z p,q,*u,*v,*x,*y,z;
  GAT0(t,CMPX,1,0); ZAV(t)[0]=z; R t;
 }    /* determinant on complex  matrix; works in place */
 
+
+// Blocked LU with partial pivoting for FL and CMPX, used by 128!:10, -/ .* and %. on large square matrices.
+// The matrix is factored in place, row-major, LUNB columns at a time.  The panel is factored by unblocked elimination with its
+// row interchanges applied to whole rows; then the trailing columns are divided among the threads, each of which solves its part
+// of the U row block against the unit lower triangle of the panel and updates its part of the trailing matrix with one gemm.
+#define LUNB 32  // panel width
+#define LUMINTRAIL 32768  // TUNE don't split a trailing update smaller than this many multiplies
+
+typedef struct {
+ C *av; I n;  // the matrix being factored, and its order
+ I j0, jb;  // first column and width of the panel
+ I colspertask;  // trailing columns, or columns of the right sides, given to each task
+ I cmpx;  // 1 if CMPX
+ C *bv; I k;  // for solve: the right sides and #columns in them
+ C *scr;  // for solve: LUNB rows of scratch for each task
+} LUCTX;
+
+static INLINE Z luzmul(Z a,Z b){Z z; z.re=a.re*b.re-a.im*b.im; z.im=a.re*b.im+a.im*b.re; R z;}
+static INLINE Z luzdiv(Z a,Z b){Z z;D r,d;  // Smith's division, which avoids overflow in |b|^2
+ if(ABS(b.re)>=ABS(b.im)){r=b.im/b.re; d=b.re+r*b.im; z.re=(a.re+a.im*r)/d; z.im=(a.im-a.re*r)/d;}
+ else{r=b.re/b.im; d=b.im+r*b.re; z.re=(a.re*r+a.im)/d; z.im=(a.im*r-a.re)/d;}
+ R z;
+}
+#define ZABS1(v) (ABS((v).re)+ABS((v).im))  // pivot magnitude, as in LAPACK izamax
+
+// factor columns j0 to j0+jb-1 of the n x n matrix a, rows j0 on.  perm is the row order so far, *sgn the sign of the permutation
+static void lupanelD(D *a,I n,I j0,I jb,I *perm,I *sgn){
+ for(I j=j0;j<j0+jb;++j){
+  I p=j; D h=ABS(a[j*n+j]); for(I r=j+1;r<n;++r){D g=ABS(a[r*n+j]); if(g>h){h=g; p=r;}}  // pivot is the largest in the column
+  if(p!=j){D *x=a+j*n, *y=a+p*n; DO(n, D t=x[i]; x[i]=y[i]; y[i]=t;) I t=perm[j]; perm[j]=perm[p]; perm[p]=t; *sgn=-*sgn;}
+  if(h==0.0)continue;  // the column is 0 from the diagonal down: nothing to eliminate
+  D *x=a+j*n;
+  for(I r=j+1;r<n;++r){D *y=a+r*n; D l=y[j]/=x[j]; if(l!=0.0)for(I k=j+1;k<j0+jb;++k)y[k]-=l*x[k];}
+ }
+}
+static void lupanelZ(Z *a,I n,I j0,I jb,I *perm,I *sgn){
+ for(I j=j0;j<j0+jb;++j){
+  I p=j; D h=ZABS1(a[j*n+j]); for(I r=j+1;r<n;++r){D g=ZABS1(a[r*n+j]); if(g>h){h=g; p=r;}}
+  if(p!=j){Z *x=a+j*n, *y=a+p*n; DO(n, Z t=x[i]; x[i]=y[i]; y[i]=t;) I t=perm[j]; perm[j]=perm[p]; perm[p]=t; *sgn=-*sgn;}
+  if(h==0.0)continue;
+  Z *x=a+j*n;
+  for(I r=j+1;r<n;++r){Z *y=a+r*n; Z l=y[j]=luzdiv(y[j],x[j]); if(l.re!=0.0||l.im!=0.0)for(I k=j+1;k<j0+jb;++k){Z t=luzmul(l,x[k]); y[k].re-=t.re; y[k].im-=t.im;}}
+ }
+}
+
+// task to finish a range of the columns after the panel: U12=L11^-1 A12, then A22-=L21 U12
+static unsigned char jtlutrailx(J jt,void *ctx,UI4 ti){LUCTX *c=ctx; I n=c->n, j0=c->j0, t0=j0+c->jb;
+ I c0=t0+ti*c->colspertask, c1=MIN(c0+c->colspertask,n); if(c0>=c1)R 0; I nc=c1-c0;
+ if(!c->cmpx){D *a=(D*)c->av;
+  for(I r=j0+1;r<t0;++r){D *y=a+r*n+c0; for(I k=j0;k<r;++k){D l=a[r*n+k]; D *x=a+k*n+c0; DO(nc, y[i]-=l*x[i];)}}
+  if(t0<n)dgemm_nn(n-t0,nc,c->jb,-1.0,a+t0*n+j0,n,1,a+j0*n+c0,n,1,1.0,a+t0*n+c0,n,1);
+ }else{Z *a=(Z*)c->av;
+  for(I r=j0+1;r<t0;++r){Z *y=a+r*n+c0; for(I k=j0;k<r;++k){Z l=a[r*n+k]; Z *x=a+k*n+c0; DO(nc, Z t=luzmul(l,x[i]); y[i].re-=t.re; y[i].im-=t.im;)}}
+  if(t0<n){dcomplex one={1.0,0.0}, mone={-1.0,0.0}; zgemm_nn(n-t0,nc,c->jb,mone,(dcomplex*)(a+t0*n+j0),n,1,(dcomplex*)(a+j0*n+c0),n,1,one,(dcomplex*)(a+t0*n+c0),n,1);}
+ }
+ R 0;
+}
+
+// LU of the square FL or CMPX table w, as a new table holding L-I+U.  *perm gets the row order (the original row of each row of LU),
+// *sgn the sign of the permutation.  A column with no nonzero pivot is left with 0 on the diagonal
+A jtlublk(J jt,A w,A *perm,I *sgn){A z,p;LUCTX c;
+ I n=AS(w)[0]; RZ(z=ca(w)); RZ(p=apvwr(n,0,1)); I *pv=IAV1(p); *sgn=1;
+ memset(&c,0,sizeof(c)); c.av=CAV(z); c.n=n; c.cmpx=!!(AT(w)&CMPX);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ for(I j0=0;j0<n;j0+=LUNB){I jb=MIN(LUNB,n-j0), nt=n-j0-jb;  // nt=#trailing columns
+  if(c.cmpx)lupanelZ(ZAV(z),n,j0,jb,pv,sgn);else lupanelD(DAV(z),n,j0,jb,pv,sgn);
+  if(!nt)break;
+  I ntasks=MIN(nthreads,(nt+LUNB-1)/LUNB); ntasks=(n-j0)*nt*jb<LUMINTRAIL?1:ntasks;
+  c.j0=j0; c.jb=jb; c.colspertask=(nt+ntasks-1)/ntasks;
+  if(ntasks>1)jtjobrun(jt,jtlutrailx,&c,ntasks,0);else jtlutrailx(jt,&c,0);
+ }
+ *perm=p; R z;
+}
+
+// task to solve L U x = b for a range of the columns of b, in place.  Blocks of LUNB rows are solved in turn: the part of each
+// that depends on the rows already solved is taken off with one gemm (into scratch, then subtracted), the rest by substitution
+static unsigned char jtlusolvex(J jt,void *ctx,UI4 ti){LUCTX *c=ctx; I n=c->n, k=c->k;
+ I c0=ti*c->colspertask, c1=MIN(c0+c->colspertask,k); if(c0>=c1)R 0; I nc=c1-c0;
+ if(!c->cmpx){D *a=(D*)c->av, *b=(D*)c->bv+c0, *s=(D*)c->scr+ti*LUNB*c->colspertask;
+  for(I r0=0;r0<n;r0+=LUNB){I rb=MIN(LUNB,n-r0);  // L y = b, top down
+   if(r0){mvc(rb*nc*SZD,s,1,MEMSET00); dgemm_nn(rb,nc,r0,1.0,a+r0*n,n,1,b,k,1,0.0,s,nc,1); DO(rb, I r=i; D *y=b+(r0+r)*k, *sr=s+r*nc; DO(nc, y[i]-=sr[i];))}
+   for(I r=r0+1;r<r0+rb;++r){D *y=b+r*k; for(I j=r0;j<r;++j){D l=a[r*n+j]; if(l!=0.0){D *x=b+j*k; DO(nc, y[i]-=l*x[i];)}}}
+  }
+  for(I r0=(n-1)&-LUNB;r0>=0;r0-=LUNB){I rb=MIN(LUNB,n-r0), e=r0+rb;  // U x = y, bottom up
+   if(e<n){mvc(rb*nc*SZD,s,1,MEMSET00); dgemm_nn(rb,nc,n-e,1.0,a+r0*n+e,n,1,b+e*k,k,1,0.0,s,nc,1); DO(rb, I r=i; D *y=b+(r0+r)*k, *sr=s+r*nc; DO(nc, y[i]-=sr[i];))}
+   for(I r=e-1;r>=r0;--r){D *y=b+r*k; for(I j=r+1;j<e;++j){D u=a[r*n+j]; if(u!=0.0){D *x=b+j*k; DO(nc, y[i]-=u*x[i];)}} D d=a[r*n+r]; DO(nc, y[i]/=d;)}
+  }
+ }else{Z *a=(Z*)c->av, *b=(Z*)c->bv+c0, *s=(Z*)c->scr+ti*LUNB*c->colspertask; dcomplex zero={0.0,0.0}, one={1.0,0.0};
+  for(I r0=0;r0<n;r0+=LUNB){I rb=MIN(LUNB,n-r0);
+   if(r0){mvc(rb*nc*sizeof(Z),s,1,MEMSET00); zgemm_nn(rb,nc,r0,one,(dcomplex*)(a+r0*n),n,1,(dcomplex*)b,k,1,zero,(dcomplex*)s,nc,1); DO(rb, I r=i; Z *y=b+(r0+r)*k, *sr=s+r*nc; DO(nc, y[i].re-=sr[i].re; y[i].im-=sr[i].im;))}
+   for(I r=r0+1;r<r0+rb;++r){Z *y=b+r*k; for(I j=r0;j<r;++j){Z l=a[r*n+j]; if(l.re!=0.0||l.im!=0.0){Z *x=b+j*k; DO(nc, Z t=luzmul(l,x[i]); y[i].re-=t.re; y[i].im-=t.im;)}}}
+  }
+  for(I r0=(n-1)&-LUNB;r0>=0;r0-=LUNB){I rb=MIN(LUNB,n-r0), e=r0+rb;
+   if(e<n){mvc(rb*nc*sizeof(Z),s,1,MEMSET00); zgemm_nn(rb,nc,n-e,one,(dcomplex*)(a+r0*n+e),n,1,(dcomplex*)(b+e*k),k,1,zero,(dcomplex*)s,nc,1); DO(rb, I r=i; Z *y=b+(r0+r)*k, *sr=s+r*nc; DO(nc, y[i].re-=sr[i].re; y[i].im-=sr[i].im;))}
+   for(I r=e-1;r>=r0;--r){Z *y=b+r*k; for(I j=r+1;j<e;++j){Z u=a[r*n+j]; if(u.re!=0.0||u.im!=0.0){Z *x=b+j*k; DO(nc, Z t=luzmul(u,x[i]); y[i].re-=t.re; y[i].im-=t.im;)}} Z d=a[r*n+r]; DO(nc, y[i]=luzdiv(y[i],d);)}
+  }
+ }
+ R 0;
+}
+
+#define LUSOLVEMINCOLS 16  // TUNE fewest right-side columns given to a task
+// Solve w x = b given lu and perm from jtlublk.  b is n x k, the type of lu, or the identity if 0 (then k=n).  Result is x, n x k
+A jtlusolve(J jt,A lu,A perm,A b,I k){A z,s;LUCTX c;
+ I n=AS(lu)[0], t=AT(lu), *pv=IAV(perm);
+ GA10(z,t,n*k);
+ if(t&CMPX){Z *zv=ZAV(z); if(b){Z *bv=ZAV(b); DO(n, MC(zv+i*k,bv+pv[i]*k,k*sizeof(Z));)}else{mvc(n*k*sizeof(Z),zv,1,MEMSET00); DO(n, zv[i*k+pv[i]].re=1.0;)}}
+ else{D *zv=DAV(z); if(b){D *bv=DAV(b); DO(n, MC(zv+i*k,bv+pv[i]*k,k*SZD);)}else{mvc(n*k*SZD,zv,1,MEMSET00); DO(n, zv[i*k+pv[i]]=1.0;)}}  // rows of b in the order of LU
+ memset(&c,0,sizeof(c)); c.av=CAV(lu); c.n=n; c.cmpx=!!(t&CMPX); c.bv=CAV(z); c.k=k;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ nthreads=MAX(1,MIN(nthreads,k/LUSOLVEMINCOLS)); c.colspertask=(k+nthreads-1)/nthreads;
+ GA10(s,t,nthreads*LUNB*c.colspertask); c.scr=CAV(s);
+ if(nthreads>1)jtjobrun(jt,jtlusolvex,&c,nthreads,0);else jtlusolvex(jt,&c,0);
+ R z;
+}
+#undef LUSOLVEMINCOLS
+
+#define LUMINDET 64  // TUNE smallest order whose determinant comes from the blocked LU; smaller ones use complete pivoting
+// determinant of the square FL or CMPX w from its blocked LU.  mark if w is not all finite, for the complete-pivoting code to handle
+static A jtdetlu(J jt,A w){A lu,p;I sgn,n=AS(w)[0];
+ if(AT(w)&FL){D *v=DAV(w); DO(AN(w), if(!isfinite(v[i]))R mark;)}else{Z *v=ZAV(w); DO(AN(w), if(!isfinite(v[i].re)||!isfinite(v[i].im))R mark;)}
+ RZ(lu=jtlublk(jt,w,&p,&sgn));
+ if(AT(w)&FL){D z=(D)sgn, *v=DAV(lu); DO(n, z*=v[i*(n+1)];) R scf(z);}
+ A t; Z z={(D)sgn,0.0}, *v=ZAV(lu); DO(n, z=luzmul(z,v[i*(n+1)]);) GAT0(t,CMPX,1,0); ZAV(t)[0]=z; R t;
+}
+
 F1(jtgaussdet){A z;I*s;
  ARGCHK1(w);
  ASSERT(2==AR(w),EVRANK);
@@ -107,11 +271,11 @@ F1(jtgaussdet){A z;I*s;
  ASSERT(s[0]==s[1],EVLENGTH);
  if(!ISSPARSE(AT(w)))
   switch(CTTZNOFLAG(AT(w))){
-  case FLX:   z=detd(ca(w));      break;
+  case FLX:   if(s[0]>=LUMINDET&&(z=jtdetlu(jt,w))!=mark)R z; z=detd(ca(w)); break;
   default:   ASSERT(0,EVDOMAIN);
   case B01X:
-  case INTX:  R detd(cvt(FL,w));
-  case CMPXX: z=detz(ca(w));      break;
+  case INTX:  RZ(w=cvt(FL,w)); R s[0]>=LUMINDET?jtdetlu(jt,w):detd(w);
+  case CMPXX: if(s[0]>=LUMINDET&&(z=jtdetlu(jt,w))!=mark)R z; z=detz(ca(w)); break;
   case XNUMX: z=detr(cvt(RAT,w)); break;
   case RATX:  z=detr(ca(w));
   }
@@ -168,6 +168,102 @@ static void jtiixfi(I*z,D*a,I*w,I n,I m,I c,B ge){I k,p,q;C x,y;
   jtiixfi_1d(z,a,w,n,RNDDN(m,IIXFA),ITERCT(n));}}
 #endif //C_AVX2 && SY_LINUX
 
+// Interval index of atoms in a sorted INT/FL list, with no mispredicted branches and with the searches of IIXN keys overlapped.
+// Every key goes through the same sequence of window lengths, so IIXN keys run in lockstep and each one's next probe is prefetched
+// while the others compute; a cache miss no longer stalls the search of every key behind it.
+// P(x,y) is true while the insertion point is past x: !(x>=y) ascending, !(x<=y) descending, as in BSLOOP1x
+#define IIXN 8
+#define IIXASC(x,y) !((x)>=(y))
+#define IIXDESC(x,y) !((x)<=(y))
+#define IIXLOCK(Ta,Tw,P)  \
+ {Ta *av=(Ta*)c->av; Tw *wv=(Tw*)c->wv+b; I n=c->n, j=0;  \
+  for(;j+IIXN<=m;j+=IIXN){Ta *u[IIXN]; Tw y[IIXN]; DO(IIXN, u[i]=av; y[i]=wv[j+i];)  \
+   for(I len=n;len>1;){I h=len>>1; len-=h; DO(IIXN, u[i]=P(u[i][h],y[i])?u[i]+h:u[i]; PREFETCH((C*)(u[i]+(len>>1)));)}  \
+   DO(IIXN, zv[j+i]=u[i]-av+P(*u[i],y[i]);)  \
+  }  \
+  for(;j<m;++j){Ta *u=av; Tw y=wv[j]; for(I len=n;len>1;){I h=len>>1; len-=h; u=P(u[h],y)?u+h:u;} zv[j]=u-av+P(*u,y);}  \
+ }
+// The same on the search tree built by m&I.: a static B+-tree whose leaves are the list in blocks of 8 and whose nodes are 8 keys, each
+// the first item under the next of the 9 children.  A node is one cache line, and choosing the child is 8 comparisons added up,
+// so a search costs about log9 n cache misses rather than lg n.  tv is the number of levels above the leaves, then the offset of each
+// level from the leaves up, then its number of nodes.  Unused keys are beyond every item; a key beyond them takes the last child
+#define IIXTREE(Ta,Tw,P)  \
+ {Ta *av=(Ta*)c->av; Tw *wv=(Tw*)c->wv+b; I n=c->n, *tv=c->tv, nl=tv[0], *off=tv+1, *cnt=tv+2+nl, j=0;  \
+  for(;j+IIXN<=m;j+=IIXN){I k[IIXN]; Tw y[IIXN]; DO(IIXN, k[i]=0; y[i]=wv[j+i];)  \
+   for(I l=nl;l>0;--l){Ta *v=av+off[l]; DO(IIXN, Ta *u=v+8*k[i]; I s=0; for(I q=0;q<8;++q)s+=P(u[q],y[i]); k[i]=MIN(9*k[i]+s,cnt[l-1]-1); PREFETCH((C*)(av+off[l-1]+8*k[i]));)}  \
+   DO(IIXN, Ta *u=av+8*k[i]; I s=0; for(I q=0;q<8;++q)s+=P(u[q],y[i]); zv[j+i]=MIN(8*k[i]+s,n);)  \
+  }  \
+  for(;j<m;++j){I k=0; Tw y=wv[j]; I s;  \
+   for(I l=nl;l>0;--l){Ta *u=av+off[l]+8*k; s=0; DQ(8, s+=P(u[i],y);) k=MIN(9*k+s,cnt[l-1]-1);}  \
+   Ta *u=av+8*k; s=0; DQ(8, s+=P(u[i],y);) zv[j]=MIN(8*k+s,n);}  \
+ }
+
+typedef struct {
+ void *av,*wv;  // the list, sorted or as a search tree; the keys
+ I *zv;  // result
+ I *tv;  // tree: #levels, offsets and node counts
+ I n,m,keyspertask;  // #items of list, #keys
+ I sel;  // 1 if list is FL, 2 if keys are FL, 4 if descending, 8 if tree
+} IIXCTX;
+
+static unsigned char jtiixx(J jt,void *ctx,UI4 ti){IIXCTX *c=ctx;
+ I b=ti*c->keyspertask, m=MIN(b+c->keyspertask,c->m)-b, *zv=c->zv+b;
+ switch(c->sel){
+ case 0:  IIXLOCK(I,I,IIXASC) break;   case 4:  IIXLOCK(I,I,IIXDESC) break;
+ case 1:  IIXLOCK(D,I,IIXASC) break;   case 5:  IIXLOCK(D,I,IIXDESC) break;
+ case 2:  IIXLOCK(I,D,IIXASC) break;   case 6:  IIXLOCK(I,D,IIXDESC) break;
+ case 3:  IIXLOCK(D,D,IIXASC) break;   case 7:  IIXLOCK(D,D,IIXDESC) break;
+ case 8:  IIXTREE(I,I,IIXASC) break;    case 12: IIXTREE(I,I,IIXDESC) break;
+ case 9:  IIXTREE(D,I,IIXASC) break;    case 13: IIXTREE(D,I,IIXDESC) break;
+ case 10: IIXTREE(I,D,IIXASC) break;    case 14: IIXTREE(I,D,IIXDESC) break;
+ case 11: IIXTREE(D,D,IIXASC) break;    case 15: IIXTREE(D,D,IIXDESC) break;
+ }
+ R 0;
+}
+
+#define IIXMINKEYS 16384  // TUNE don't start a task for fewer keys than this
+// search for the m keys at w in the list of n at a, into zv.  The keys are divided among the threads of threadpool 0
+static void jtiixrun(J jt,void *av,I n,I at,A w,I *zv,I *tv,I desc){IIXCTX c;
+ c.av=av; c.wv=voidAV(w); c.zv=zv; c.tv=tv; c.n=n; c.m=AN(w);
+ c.sel=(at&FL?1:0)+(AT(w)&FL?2:0)+4*desc+(tv?8:0);
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.m)&(1-nthreads)&(IIXMINKEYS-c.m))>=0)nthreads=1;  // if one key, one thread, or a small job, use one thread
+ nthreads=MIN(nthreads,c.m); c.keyspertask=(c.m+nthreads-1)/nthreads;
+ if(nthreads>1)jtjobrun(jt,jtiixx,&c,nthreads,0);else jtiixx(jt,&c,0);
+}
+
+// m&I. on a sorted INT or FL list: build the search tree once.  Result is (tree;levels;descending), or empty if m is not suitable.
+// The tree is the list padded to a multiple of 8, then the nodes of each level up to the root
+#define IIXTREEMIN 1048576  // TUNE shorter lists are searched as fast in the list itself
+#define TREEFILL(T,lo,hi) {T *u=(T*)voidAV(w), *v=(T*)voidAV(x), pad=desc?lo:hi;  \
+ MC(v,u,n*sizeof(T)); DQ(8*cnt[0]-n, v[n+i]=pad;)  \
+ for(I l=1,span=8;l<=nl;++l,span*=9){T *d=v+off[l]; DO(cnt[l], I k=i; DO(8, I p=(9*k+i+1)*span; d[8*k+i]=p<n?u[p]:pad;))}  \
+}
+F1(jticapcompile){A h,*hv,t,x;I n,desc,nl,tot;
+ ARGCHK1(w);
+ n=AN(w); if(AR(w)!=1||!(AT(w)&INT+FL)||ISSPARSE(AT(w))||n<IIXTREEMIN)R mtv;
+ if(AT(w)&INT)desc=IAV(w)[0]>IAV(w)[n-1];else{D *u=DAV(w); desc=u[0]!=u[n-1]&&!(u[0]<u[n-1]);}  // descending as decided by COMPVLOOP
+ for(nl=0,tot=(n+7)>>3;tot>1;++nl)tot=(tot+8)/9;  // number of levels above the leaves
+ GATV0(t,INT,3+2*nl,1); I *off=AV(t)+1, *cnt=off+nl+1; AV(t)[0]=nl;
+ cnt[0]=(n+7)>>3; off[0]=0; tot=8*cnt[0];
+ DO(nl, cnt[i+1]=(cnt[i]+8)/9; off[i+1]=tot; tot+=8*cnt[i+1];)
+ GA10(x,AT(w),tot);
+ if(AT(w)&INT)TREEFILL(I,IMIN,IMAX) else TREEFILL(D,-inf,inf)
+ GAT0(h,BOX,3,1); hv=AAV(h);
+ hv[0]=incorp(x); hv[1]=incorp(t); RZ(hv[2]=incorp(sc(desc)));
+ R h;
+}
+
+// (m&I.) y, using the layout built by jticapcompile
+DF1(jticapfixedleft){A a,h,*hv,z;
+ ARGCHK1(w);
+ a=FAV(self)->fgh[0]; h=FAV(self)->fgh[2]; hv=AAV(h);
+ if(!(AT(w)&INT+FL)||ISSPARSE(AT(w))||!AN(w))R jticap2(jt,a,w,ds(CICAP));  // other types, and empties, as usual
+ GATV(z,INT,AN(w),AR(w),AS(w));
+ jtiixrun(jt,voidAV(C(hv[0])),AN(a),AT(a),w,AV(z),AV(C(hv[1])),AV(C(hv[2]))[0]);
+ RETF(z);
+}
+
 // x I. y
 DF2(jticap2){A*av,*wv,z;C*uu,*vv;I ar,*as,at,b,c,ck,cm,ge,gt,j,k,m,n,p,q,r,t,wr,*ws,wt,* RESTRICT zv;I cc;
  ARGCHK2(a,w);
@@ -240,6 +336,9 @@ DF2(jticap2){A*av,*wv,z;C*uu,*vv;I ar,*as,at,b,c,ck,cm,ge,gt,j,k,m,n,p,q,r,t,wr,
     *zv++=1+q;
    }
  }else{
+#ifndef FAST_IIX
+  if(c==1&&!((at|wt)&~(INT|FL))){jtiixrun(jt,voidAV(a),n,at,w,zv,0,ge==1); RETF(z);}  // atoms in INT/FL: lockstep search, threaded
+#endif
   // loop on the argument types.  We handle the plausible combinations without requiring a conversion
   switch(CVCASE(CTTZ(at),CTTZ(wt))){
   case CVCASE(B01X, B01X ): BSLOOP(C, C); break;
@@ -501,7 +501,7 @@ AHDR2(cirEE,E,E,E){I k=(I)jround(x->hi);
 
 static E jtpospowE(J jt,E x,E y){
  if(unlikely(0==y.hi))R (E){.hi=1.0,.lo=0.};
- if(unlikely(0==y.hi))R (E){.hi=0<y.hi?0.0:inf,.lo=0.};
+ if(unlikely(0==x.hi))R (E){.hi=0<y.hi?0.0:inf,.lo=0.};
  if(0<x.hi){
   R f128toe(Sleef_expq1_u10(Sleef_mulq1_u05(etof128(y),Sleef_logq1_u10(etof128(x)))));
  }
@@ -516,6 +516,7 @@ APFX(powEE, E,E,E, pospowE,,HDR1JERR)
 F2(jtlogar2){A z;I t;
  ARGCHK2(a,w); 
  RE(t=maxtype(AT(a),AT(w)));
+ if(unlikely(t&QP)){if(!(AT(a)&QP))RZ(a=cvt(QP,a)) if(!(AT(w)&QP))RZ(w=cvt(QP,w))}  // take both logs in QP, not just the QP one
  if(!(t&XNUM)||jt->xmode==XMEXACT){jt->xmode=XMEXACT; R jtatomic2(JTIPAW,logar1(w),logar1(a),ds(CDIV));}  // better to multiply by recip, but not much, & it makes 0 ^. 0 not fail
  z=rank2ex0(cvt(XNUM,a),cvt(XNUM,w),DUMMYSELF,jtxlog2a); 
  if(z)R z;
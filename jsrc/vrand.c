@@ -5,12 +5,13 @@
 
 #include "j.h"
 
-#define NRNG        5     /* # of available RNGs+1 (excluding 0)             */
+#define NRNG        6     /* # of available RNGs+1 (excluding 0)             */
 #define SMI         0     /* sum of all RNGs                               */
 #define GBI         1     /* gb_flip, Knuth 1994                           */
 #define MTI         2     /* Mersenne Twister, Matsumoto & Nishimura, 2002 */
 #define DXI         3     /* DX-1597-4d, Deng, 2005                        */
 #define MRI         4     /* MRG32k3a, L'Ecuyer, 1999                      */
+#define PXI         5     /* Philox4x32-10, Salmon et al., 2011            */
 
 #define x31         ((UI)0x80000000)
 #define x63         ((UI)0x8000000000000000)
@@ -424,6 +425,106 @@ F1(jtmr_test){I j=jt->rngdata->rng,x;
 }
 
 
+/* ----------------------------------------------------------------------- */
+/* Philox4x32-10, Salmon, Moraes, Dror & Shaw, 2011                        */
+/* Counter-based: block c of the stream is a function of the key (the      */
+/* seed) and c alone, so any part of the stream can be made independently. */
+
+#define PXN         10    /* key, position of next word, 8 words of the block holding it */
+#define PXWPC       (SY_64?2:4)  /* # random words from one counter           */
+#define PXM0        0xD2511F53
+#define PXM1        0xCD9E8D57
+#define PXW0        0x9E3779B9
+#define PXW1        0xBB67AE85
+
+// write the words for the n counters starting at c, under key k, to z.  sd is the high half of the counter, which selects a substream; the main stream is 0
+static void pxblock(UI k,UI c,UI sd,UI*z,I n){UI4 k0=(UI4)k, k1=(UI4)((UI8)k>>32); I i=0;
+#if (C_AVX2 || EMU_AVX2) && SY_64
+ // 4 counters at a time, one in each 64-bit lane; _mm256_mul_epu32 gives the full product of the low halves
+ __m256i m32=_mm256_set1_epi64x(0xffffffff), m0=_mm256_set1_epi64x(PXM0), m1=_mm256_set1_epi64x(PXM1);
+ for(;i+4<=n;i+=4){
+  __m256i ctr=_mm256_add_epi64(_mm256_set1_epi64x(c+i),_mm256_set_epi64x(3,2,1,0));
+  __m256i x0=_mm256_and_si256(ctr,m32), x1=_mm256_srli_epi64(ctr,32), x2=_mm256_set1_epi64x((UI4)sd), x3=_mm256_set1_epi64x((UI4)((UI8)sd>>32)); UI4 q0=k0, q1=k1;
+  for(I r=0;r<10;++r){__m256i p0=_mm256_mul_epu32(x0,m0), p1=_mm256_mul_epu32(x2,m1);
+   x0=_mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1,32),x1),_mm256_set1_epi64x(q0)); x1=_mm256_and_si256(p1,m32);
+   x2=_mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0,32),x3),_mm256_set1_epi64x(q1)); x3=_mm256_and_si256(p0,m32);
+   q0+=PXW0; q1+=PXW1;
+  }
+  UI t0[4],t1[4];
+  _mm256_storeu_si256((__m256i*)t0,_mm256_or_si256(x0,_mm256_slli_epi64(x1,32))); _mm256_storeu_si256((__m256i*)t1,_mm256_or_si256(x2,_mm256_slli_epi64(x3,32)));
+  DO(4, z[2*i]=t0[i]; z[2*i+1]=t1[i];) z+=8;
+ }
+#endif
+ for(;i<n;++i){UI8 cc=(UI8)c+i; UI4 x0=(UI4)cc, x1=(UI4)(cc>>32), x2=(UI4)sd, x3=(UI4)((UI8)sd>>32), q0=k0, q1=k1;
+  for(I r=0;r<10;++r){UI8 p0=(UI8)PXM0*x0, p1=(UI8)PXM1*x2;
+   x0=(UI4)(p1>>32)^x1^q0; x1=(UI4)p1; x2=(UI4)(p0>>32)^x3^q1; x3=(UI4)p0;
+   q0+=PXW0; q1+=PXW1;
+  }
+#if SY_64
+  z[0]=x0|(UI)x1<<32; z[1]=x2|(UI)x3<<32; z+=2;
+#else
+  z[0]=x0; z[1]=x1; z[2]=x2; z[3]=x3; z+=4;
+#endif
+ }
+}
+
+// recompute the buffered block for the position in v[1]
+static void pxrefill(UI*v){pxblock(v[0],(v[1]&~(UI)7)/PXWPC,0,v+2,8/PXWPC);}
+
+static UI jtpx_next(J jt){UI*v=jt->rngdata->rngv,p=v[1];
+ if(!(p&7))pxrefill(v);
+ v[1]=p+1; R v[2+(p&7)];
+}
+
+static void jtpx_init(J jt,UI s){UI*v=jt->rngdata->rngv;
+ v[0]=s; v[1]=0;  // the buffer is filled by the first px_next
+ jt->rngdata->rngi=0;
+}
+
+#if SY_64
+// Bulk generation.  A request for n words is divided among the threads by position in the stream, so the result does not
+// depend on the number of threads.  Each task turns its words into results as it goes; op says how
+typedef struct {
+ UI key, c0;  // key, and the counter for the first word given to the tasks
+ I nw, j0;  // # words given to the tasks, and the index of the first of them in the request
+ I wpt;  // # words for each task, a multiple of PXCHUNK
+ void *z;  // result area
+ D md;  // op 2: m*2^_64
+ I lg, p;  // op 4: lg(m), # values per word
+ C op;  // 0=raw words, 1=float in (0,1), 2=integer below m, 3=8 bytes of 8 Booleans, 4=p values of lg bits
+} PXCTX;
+
+// apply c->op to the n words at t, which are words j... of the request
+static void pxout(PXCTX *c,UI*t,I j,I n){
+ switch(c->op){
+  case 0: MC((UI*)c->z+j,t,n*SZI); break;
+  case 1: {D*z=(D*)c->z+j; DO(n, z[i]=(0.5+X52/2)+X64*(I)(t[i]&(UI)0xfffffffffffff000);) break;}  // as NEXTD1
+  case 2: {I*z=(I*)c->z+j; D md=c->md; DO(n, z[i]=(I)(md*((D)(I)t[i]+(D)x63));) break;}  // as the floating-point path in rollksub
+  case 3: {UI*z=(UI*)c->z+8*j; DO(n, UI w=t[i]; DQ(8, *z++=(UI)0x0101010101010101&w; w>>=1;)) break;}
+  case 4: {I*z=(I*)c->z+c->p*j; I lg=c->lg, p=c->p; UI mk=((UI)1<<lg)-1; DO(n, UI w=t[i]; DQ(p, *z++=mk&w; w>>=lg;)) break;}
+ }
+}
+
+#define PXCHUNK 256  // words made at a time
+static unsigned char jtpxfillx(J jt,void *ctx,UI4 ti){PXCTX *c=ctx; UI t[PXCHUNK];
+ I b=ti*c->wpt, e=MIN(b+c->wpt,c->nw);
+ for(;b<e;b+=PXCHUNK){I n=MIN(PXCHUNK,e-b); pxblock(c->key,c->c0+b/PXWPC,0,t,(n+PXWPC-1)/PXWPC); pxout(c,t,c->j0+b,n);}
+ R 0;
+}
+
+#define PXMINWORDS 16384  // TUNE don't start a task for fewer words than this
+// take the next n words of the PX stream, applying c->op, and advance the state past them.  Words left in the buffer are used first
+static void jtpxfill(J jt,PXCTX *c,I n){UI*v=jt->rngdata->rngv; I j=0;
+ for(;j<n&&v[1]&7;++j){UI t=v[2+(v[1]&7)]; ++v[1]; pxout(c,&t,j,1);}
+ c->key=v[0]; c->c0=v[1]/PXWPC; c->nw=n-j; c->j0=j; if(!c->nw)R;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(PXMINWORDS-c->nw))>=0)nthreads=1;  // one thread or a small job: don't split
+ c->wpt=((c->nw+nthreads-1)/nthreads+PXCHUNK-1)&-PXCHUNK; nthreads=(c->nw+c->wpt-1)/c->wpt;
+ if(nthreads>1)jtjobrun(jt,jtpxfillx,c,nthreads,0);else jtpxfillx(jt,c,0);
+ v[1]+=c->nw; if(v[1]&7)pxrefill(v);  // a partly used block goes into the buffer
+}
+#endif
+
 /* ----------------------------------------------------------------------- */
 /* sum of all RNGs                                                         */
 
@@ -448,6 +549,9 @@ F1(jtrngraw){A z;I n,*v;SETNEXT
  RE(n=i0(w));
  ASSERT(0<=n,EVDOMAIN);
  GATV0(z,INT,n,1); v=AV(z);
+#if SY_64
+ if(jt->rngdata->rng==PXI){PXCTX c; c.op=0; c.z=v; pxfill(&c,n); R z;}
+#endif
  DQ(n, *v++=NEXT;);
  R z;
 }
@@ -459,11 +563,13 @@ B jtrnginit(J jt){
  jt->rngdata->rngparms[2].rngF=jtmt_next; jt->rngdata->rngparms[2].rngS=16807;
  jt->rngdata->rngparms[3].rngF=jtdx_next; jt->rngdata->rngparms[3].rngS=16807;
  jt->rngdata->rngparms[4].rngF=jtmr_next; jt->rngdata->rngparms[4].rngS=16807;
+ jt->rngdata->rngparms[5].rngF=jtpx_next; jt->rngdata->rngparms[5].rngS=16807;
  jt->rngdata->rngparms[0].rngM=SY_64?0:0;             /*   %      2^32 */
  jt->rngdata->rngparms[1].rngM=SY_64?0:2147483648UL;  /*   %      2^31 */
  jt->rngdata->rngparms[2].rngM=0;                     /*   %      2^32 */
  jt->rngdata->rngparms[3].rngM=SY_64?0:2147483648UL;  /*   %   _1+2^31 */  /* fudge; should be _1+2^31 */
  jt->rngdata->rngparms[4].rngM=SY_64?0:4294967087UL;  /*   % _209+2^32 */
+ jt->rngdata->rngparms[5].rngM=0;                     /*   %      2^32 */
  jt->rngdata->rngparms0[GBI].rngI=54;
  rngselects(num(2));
  R 1;
@@ -479,6 +585,7 @@ static B jtrngga(J jt,I i,struct rngparms*vv){
    case MTI: t=INT; n=MTN; f=jtmt_init; break;
    case DXI: t=INT; n=DXN; f=jtdx_init; break;
    case MRI: t=FL;  n=MRN; f=jtmr_init; break;
+   case PXI: t=INT; n=PXN; f=jtpx_init; break;
   }
   GA10(x,t,n); ACINITZAP(x); vv[i].rngV=jt->rngdata->rngv=AV(x);   // x will never be freed, but that's OK, it's inited only once
   f(jt,jt->rngdata->rngparms[i].rngS); jt->rngdata->rngparms[i].rngI=jt->rngdata->rngi;
@@ -497,6 +604,7 @@ F1(jtrngselects){I i;struct rngparms*vv=jt->rngdata->rngparms;
   case MTI: RZ(rngga(i,  vv)); jt->rngdata->rngw=SY_64?64:32; break; 
   case DXI: RZ(rngga(i,  vv)); jt->rngdata->rngw=SY_64?64:30; break;
   case MRI: RZ(rngga(i,  vv)); jt->rngdata->rngw=SY_64?64:31; break;
+  case PXI: RZ(rngga(i,  vv)); jt->rngdata->rngw=SY_64?64:32; break;
  }
  R mtv;
 }
@@ -525,6 +633,7 @@ F1(jtrngstateq){A x=0,z,*zv;D*u=0;I n;UI*v;
 #else
   case MRI: n=MRN; u=(D*)jt->rngdata->rngv; GATV0(x,INT,n,1); v=AV(x); DO(n, v[i]=(UI)u[i];); break;
 #endif
+  case PXI: n=2;   v=jt->rngdata->rngv; break;  // key and position; the buffer is recomputed from them
  }
  GAT0(z,BOX,3,1); zv=AAV(z);
  RZ(*zv++=incorp(sc(jt->rngdata->rng))); RZ(*zv++=incorp(sc(jt->rngdata->rngi))); RZ(*zv++=incorp(vec(INT,n,v)));
@@ -561,6 +670,7 @@ F1(jtrngstates){A*wv;I k;struct rngparms*vv=jt->rngdata->rngparms;
   case MTI: RE(k=i0(C(wv[1]))); RZ(rngstates1(MTI,MTN,vv,0,k,C(wv[2]),0)); break;
   case DXI: RE(k=i0(C(wv[1]))); RZ(rngstates1(DXI,DXN,vv,0,k,C(wv[2]),1)); break;
   case MRI: RE(k=i0(C(wv[1]))); RZ(rngstates1(MRI,MRN,vv,0,k,C(wv[2]),0)); break;
+  case PXI: RE(k=i0(C(wv[1]))); ASSERT(k==0,EVINDEX); RZ(rngstates1(PXI,2,vv,0,k,C(wv[2]),0)); if(vv[PXI].rngV[1]&7)pxrefill(vv[PXI].rngV); break;
  }
  R mtv;
 }
@@ -585,6 +695,7 @@ F1(jtrngseeds){I k,r;
   case MTI:                     mt_init((UI)k); break;
   case DXI: ASSERT(k!=0,EVDOMAIN); dx_init(k);     break;
   case MRI: ASSERT(k!=0,EVDOMAIN); mr_init(k); break;
+  case PXI:                     px_init(k);     break;
  }
  jt->rngdata->rngparms[jt->rngdata->rng].rngS=k;  // Save first value, in case k is atomic
  if(!r&&MTI==jt->rngdata->rng&&jt->rngdata->rngseed){fa(jt->rngdata->rngseed); jt->rngdata->rngseed=0;}   // If k is atomic, discard jt->rngdata->rngseed if there is one
@@ -598,6 +709,10 @@ static F2(jtrollksub){A z;I an,*av,k,m1,n,p,q,r,sh;UI m,mk,s,t,*u,x=jt->rngdata-
  an=AN(a); RE(m1=i0(w)); ASSERT(0<=m1,EVDOMAIN); m=m1;
  RZ(a=vip(a)); av=AV(a); PRODX(n,an,av,1);
  GA(z,0==m?FL:2==m?B01:INT,n,an,av); u=(UI*)AV(z);
+#if SY_64
+ PXCTX c; I px=jt->rngdata->rng==PXI;  // Philox results are made in bulk, one word per value (p values for power-of-2 m)
+ if(px&&!m){c.op=1; c.z=u; pxfill(&c,n); R z;}
+#endif
  if(!m){D*v=DAV(z); INITD; if(sh)DQ(n, *v++=NEXTD1;)else DQ(n, *v++=NEXTD0;);}  // floating-point output
  else if(2==m){I nslice; I j;
   // binary output
@@ -608,9 +723,13 @@ static F2(jtrollksub){A z;I an,*av,k,m1,n,p,q,r,sh;UI m,mk,s,t,*u,x=jt->rngdata-
   mk=(UI)0x0101010101010101;
 #else
   mk=0x01010101;
+#endif
+  j=0;
+#if SY_64
+  if(px){c.op=3; c.z=u; pxfill(&c,q); u+=8*q; j=q;}
 #endif
   // Loop to output all the p-size blocks
-  for(j=0;j<q;++j){
+  for(;j<q;++j){
    t=NEXT;
    DQ(nslice, *u++=mk&t; t>>=1;);
   }
@@ -626,6 +745,13 @@ static F2(jtrollksub){A z;I an,*av,k,m1,n,p,q,r,sh;UI m,mk,s,t,*u,x=jt->rngdata-
  }else{
   // integer output
   r=n; s=GMOF(m,x); if(s==x)s=0;
+#if SY_64
+  if(px){
+   // Philox words are full 64-bit, so a power of 2 needs no rejection
+   if(m>1&&!(m&(m-1))){c.lg=CTTZI(m); c.p=BW/c.lg; q=n/c.p; c.op=4; c.z=u; pxfill(&c,q); u+=c.p*q; r-=c.p*q;}
+   if(m<(1LL<<50)){c.op=2; c.md=m*X64; c.z=u; pxfill(&c,r); R z;}
+  }else
+#endif
   if(m>1&&!(m&(m-1))){
    if(s==0)s=0-m;  // since we reject t>=s, we must make s less than IMAX.  This is the max possible multiple of s.  We don't check for s=0 in this path.  s==0 possible only in 32-bit
    // here if w is a power of 2, >2; take bits from each value.  s cannot be 0
@@ -723,6 +849,7 @@ static A jtroll2(J jt,A w,B*b){A z;I j,n,nslice,p,q,r,*v;UI mk,t,*zv;SETNEXT
  *b=0; n=AN(w); v=AV(w);  // init failure return; n=#atoms of w, v->first atom
  // If w contains non-2, return with error
  DO(n, if(v[i]!=2)R mark;);   // return fast if not all-Boolean result
+ if(jt->rngdata->rng==PXI){*b=1; R rollksub(shape(w),num(2));}  // bulk generation
  // See how many RNG values to use.  jt->rngdata->rngw gives the number of bits in a generated random #
  // We will shift these out 4 or 8 bits at a time; the number of slices we can get out of
  // a random number is 8 - the number of non-random bits at the top of a word.  p will be the number
@@ -784,7 +911,7 @@ F1(jtroll){A z;B b=0;I m,wt;
  if(wt&XNUM+RAT)R rollxnum(w);
  RZ(w=vi(w)); m=AV(w)[0];
  if(    2==m)RZ(z=roll2   (w,&b));
- if(!b&&0!=m)RZ(z=rollnot0(w,&b));
+ if(!b      )RZ(z=rollnot0(w,&b));  // all 0 is a run of floats, which rollnot0 passes to rollksub
  if(!b      )RZ(z=rollany (w,&b));
  RETF(z&&!(FL&AT(z))&&wt&XNUM+RAT?xco1(z):z);
 }
@@ -832,6 +959,182 @@ DF2(jtdeal){A z;I at,j,k,m,n,wt,*zv;UI c,s,t,x=jt->rngdata->rngparms[jt->rngdata
  RETF(at&XNUM+RAT||wt&XNUM+RAT?xco1(z):z);
 }
 
+// 128!:24 samples from other distributions.  x is (kind, parameters), y is the shape of the result.
+// kind 0 normal (mean 0, standard deviation 1), 1 exponential (mean 1), 2 gamma (shape, scale 1), 3 Poisson (mean), 4 binomial (#trials, probability).
+// Trailing parameters shown with values may be omitted.  128!:24 y is x=0.  The result is written in place: normal and exponential values
+// are made from the uniforms of n ?@$ 0 (Box-Muller on 4 pairs at a time, -log u), and the transform is divided among the threads.
+// The others use rejection and so take a varying number of words; under generator 5 each block of RDBLK values draws from its own substream
+// and the blocks are divided among the threads, otherwise the values are made in order from the current generator.
+typedef struct {
+ UF f; J jt;  // the current generator, if sd is 0
+ UI key, c, sd; I i; UI w[8];  // Philox substream sd: key, next counter, words buffered and the index of the next
+ D nrm; C hasnrm;  // the second value from the last Box-Muller pair
+} RDSRC;
+
+static INLINE UI rdword(RDSRC *s){
+ if(s->sd){if(s->i==8){pxblock(s->key,s->c,s->sd,s->w,8/PXWPC); s->c+=8/PXWPC; s->i=0;} R s->w[s->i++];}
+ R nextrand(s->jt,s->f);
+}
+// uniform in (0,1), never 0 so its log is finite
+static INLINE D rdunif(RDSRC *s){
+#if SY_64
+ R (0.5+X52/2)+X64*(I)(rdword(s)&(UI)0xfffffffffffff000);
+#else
+ UI a=rdword(s), b=rdword(s); R ((D)(a>>5)*67108864.0+(D)(b>>6)+0.5)*(1.0/9007199254740992.0);
+#endif
+}
+static D rdnorm(RDSRC *s){
+ if(s->hasnrm){s->hasnrm=0; R s->nrm;}
+ D r=sqrt(-2.0*log(rdunif(s))), a=2*PI*rdunif(s);
+ s->nrm=r*sin(a); s->hasnrm=1; R r*cos(a);
+}
+
+// log k!, by Stirling's series beyond the table
+static D logfact(D k){
+ static const D t[10]={0.0,0.0,0.69314718055994531,1.79175946922805500,3.17805383034794562,4.78749174278204599,6.57925121201010100,8.52516136106541430,10.60460290274525023,12.80182748008146961};
+ if(k<10)R t[(I)k];
+ D r=1.0/(k+1), r2=r*r;
+ R (k+0.5)*log(k+1)-(k+1)+0.91893853320467274178+r*(1.0/12-r2*(1.0/360-r2*(1.0/1260)));
+}
+
+// gamma with shape a, scale 1: Marsaglia & Tsang, ACM TOMS 26 (2000)
+static D rdgamma(RDSRC *s,D a){
+ if(a<1.0)R rdgamma(s,a+1.0)*pow(rdunif(s),1.0/a);
+ D d=a-1.0/3.0, c=1.0/sqrt(9.0*d);
+ NOUNROLL while(1){D x,v,u;
+  do{x=rdnorm(s); v=1.0+c*x;}while(v<=0.0);
+  v=v*v*v; u=rdunif(s);
+  if(u<1.0-0.0331*x*x*x*x||log(u)<0.5*x*x+d*(1.0-v+log(v)))R d*v;
+ }
+}
+
+// Poisson: by products of uniforms for small means, else transformed rejection (PTRS), Hormann, Insurance: Math. & Econ. 12 (1993)
+static D rdpoisson(RDSRC *s,D m){
+ if(m<10.0){D e=exp(-m), p=1.0; I k=0; NOUNROLL while((p*=rdunif(s))>e)++k; R (D)k;}
+ D sl=sqrt(m), ll=log(m), b=0.931+2.53*sl, a=-0.059+0.02483*b, lia=log(1.1239+1.1328/(b-3.4)), vr=0.9277-3.6224/(b-2.0);
+ NOUNROLL while(1){
+  D u=rdunif(s)-0.5, v=rdunif(s), us=0.5-fabs(u), k=floor((2.0*a/us+b)*u+m+0.43);
+  if(us>=0.07&&v<=vr)R k;
+  if(k<0.0||(us<0.013&&v>us))continue;
+  if(log(v)+lia-log(a/(us*us)+b)<=-m+k*ll-logfact(k))R k;
+ }
+}
+
+// binomial: by inversion for small means, else transformed rejection (BTRS), Hormann, J. Stat. Comp. Sim. 46 (1993)
+static D rdbinom(RDSRC *s,D n,D p){
+ if(p>0.5)R n-rdbinom(s,n,1.0-p);
+ if(p==0.0)R 0.0;
+ D q=1.0-p, np=n*p;
+ if(np<30.0){
+  D qn=exp(n*log1p(-p)), bound=MIN(n,np+10.0*sqrt(np*q+1.0)), x=0.0, px=qn, u=rdunif(s);
+  NOUNROLL while(u>px){x+=1.0; if(x>bound){x=0.0; px=qn; u=rdunif(s);}else{u-=px; px=((n-x+1.0)*p*px)/(x*q);}}
+  R x;
+ }
+ D spq=sqrt(np*q), b=1.15+2.53*spq, a=-0.0873+0.0248*b+0.01*p, c=np+0.5, vr=0.92-4.2/b, alpha=(2.83+5.1/b)*spq, lpq=log(p/q);
+ D m=floor((n+1.0)*p), h=logfact(m)+logfact(n-m);
+ NOUNROLL while(1){
+  D u=rdunif(s)-0.5, v=rdunif(s), us=0.5-fabs(u), k=floor((2.0*a/us+b)*u+c);
+  if(k<0.0||k>n)continue;
+  if(us>=0.07&&v<=vr)R k;
+  if(log(v*alpha/(a/(us*us)+b))<=h-logfact(k)-logfact(n-k)+(k-m)*lpq)R k;
+ }
+}
+
+typedef struct {
+ void *z; I n;  // result, # values
+ D p0, p1;  // parameters
+ I pertask;  // # values (a multiple of 8) or # blocks given to each task
+ UF f;  // the generator, when it is not Philox
+ UI key, sd0;  // for Philox, the key, and the substream of block 0
+ C kind;
+} RDCTX;
+
+#define RDBLK 4096  // values in a block that has its own substream
+static unsigned char jtrdistx(J jt,void *ctx,UI4 ti){RDCTX *c=ctx;
+ if(c->kind<2){
+  // transform the uniforms in [b,e) in place.  Box-Muller pairs are (i,i+4) in each block of 8, then (i,i+1)
+  D *z=(D*)c->z+ti*c->pertask; I n=MIN(c->pertask,c->n-ti*c->pertask); D m=c->p0, sdv=c->p1; I i=0;
+  if(c->kind==0){
+#if SLEEF && (C_AVX2 || EMU_AVX2)
+   __m256d tp=_mm256_set1_pd(2*PI), m2=_mm256_set1_pd(-2.0), mv=_mm256_set1_pd(m), sv=_mm256_set1_pd(sdv);
+   for(;i+8<=n;i+=8){
+    __m256d r=_mm256_sqrt_pd(_mm256_mul_pd(m2,Sleef_logd4(_mm256_loadu_pd(z+i)))), a=_mm256_mul_pd(tp,_mm256_loadu_pd(z+i+4));
+    _mm256_storeu_pd(z+i,_mm256_add_pd(mv,_mm256_mul_pd(sv,_mm256_mul_pd(r,Sleef_cosd4(a)))));
+    _mm256_storeu_pd(z+i+4,_mm256_add_pd(mv,_mm256_mul_pd(sv,_mm256_mul_pd(r,Sleef_sind4(a)))));
+   }
+#endif
+   for(;i+8<=n;i+=8)for(I j=i;j<i+4;++j){D r=sqrt(-2.0*log(z[j])), a=2*PI*z[j+4]; z[j]=m+sdv*r*cos(a); z[j+4]=m+sdv*r*sin(a);}
+   for(;i+2<=n;i+=2){D r=sqrt(-2.0*log(z[i])), a=2*PI*z[i+1]; z[i]=m+sdv*r*cos(a); z[i+1]=m+sdv*r*sin(a);}
+   // an odd last value is finished by the caller
+  }else{
+#if SLEEF && (C_AVX2 || EMU_AVX2)
+   __m256d mv=_mm256_set1_pd(-m);
+   for(;i+4<=n;i+=4)_mm256_storeu_pd(z+i,_mm256_mul_pd(mv,Sleef_logd4(_mm256_loadu_pd(z+i))));
+#endif
+   for(;i<n;++i)z[i]=-m*log(z[i]);
+  }
+ }else{
+  // rejection: each block in turn
+  I nb=(c->n+RDBLK-1)/RDBLK, b=ti*c->pertask, e=MIN(b+c->pertask,nb); RDSRC s; s.f=c->f; s.jt=jt; s.key=c->key;
+  for(;b<e;++b){I i=b*RDBLK, ie=MIN(i+RDBLK,c->n);
+   s.sd=c->sd0?c->sd0+b:0; s.c=0; s.i=8; s.hasnrm=0;  // a block depends only on its substream
+   switch(c->kind){
+    case 2: {D*z=c->z; for(;i<ie;++i)z[i]=c->p1*rdgamma(&s,c->p0);} break;
+    case 3: {I*z=c->z; for(;i<ie;++i)z[i]=(I)rdpoisson(&s,c->p0);} break;
+    case 4: {I*z=c->z; for(;i<ie;++i)z[i]=(I)rdbinom(&s,c->p0,c->p1);} break;
+   }
+  }
+ }
+ R 0;
+}
+
+#define RDMINATOMS 16384  // TUNE don't start a task for fewer values than this
+F2(jtrandist2){A z;I an,*av,k,n;D p[2];SETNEXT
+ ARGCHK2(a,w);
+ ASSERT(!ISSPARSE(AT(a)|AT(w)),EVDOMAIN)
+ ASSERT(AR(a)<=1,EVRANK) ASSERT(BETWEENC(AN(a),1,3),EVLENGTH) RZ(a=cvt(FL,a)); D *xv=DAV(a);
+ k=(I)xv[0]; ASSERT(xv[0]==(D)k&&BETWEENC(k,0,4),EVDOMAIN)
+ static const D dflt[5][2]={{0.0,1.0},{1.0,0.0},{0.0,1.0},{0.0,0.0},{0.0,0.0}};  // defaults
+ static const C np[5]={2,1,2,1,2}, nreq[5]={0,0,1,1,2};  // # parameters, # required
+ ASSERT(BETWEENC(AN(a)-1,nreq[k],np[k]),EVLENGTH)
+ DO(2, p[i]=i+1<AN(a)?xv[i+1]:dflt[k][i];)
+ switch(k){
+  case 0: ASSERT(p[1]>=0.0,EVDOMAIN) break;
+  case 1: ASSERT(p[0]>=0.0,EVDOMAIN) break;
+  case 2: ASSERT(p[0]>0.0&&p[1]>0.0,EVDOMAIN) break;
+  case 3: ASSERT(p[0]>=0.0,EVDOMAIN) ASSERT(p[0]<(D)(1LL<<(BW==64?50:30)),EVLIMIT) break;
+  case 4: ASSERT(p[0]>=0.0&&p[0]==floor(p[0])&&p[1]>=0.0&&p[1]<=1.0,EVDOMAIN) ASSERT(p[0]<(D)(1LL<<(BW==64?50:30)),EVLIMIT) break;
+ }
+ ASSERT(!(p[0]!=p[0]||p[1]!=p[1]),EVDOMAIN)  // no NaN parameters
+ RZ(w=vip(w)); an=AN(w); av=AV(w); PRODX(n,an,av,1);
+ GA(z,k<3?FL:INT,n,an,av); if(!n)R z;
+ RDCTX c; c.z=voidAV(z); c.n=n; c.p0=p[0]; c.p1=p[1]; c.kind=k; c.f=nextfn; c.sd0=0;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(RDMINATOMS-n))>=0)nthreads=1;  // one thread or a small job
+ if(k<2){
+  // the uniforms, exactly as n ?@$ 0
+  D *v=DAV(z);
+#if SY_64
+  if(jt->rngdata->rng==PXI){PXCTX pc; pc.op=1; pc.z=v; pxfill(&pc,n);}else
+#endif
+  {I mk,sh; INITD; if(sh)DQ(n, *v++=NEXTD1;)else DQ(n, *v++=NEXTD0;);}
+  c.pertask=(((n+nthreads-1)/nthreads)+7)&-8; nthreads=(n+c.pertask-1)/c.pertask;
+  if(nthreads>1)jtjobrun(jt,jtrdistx,&c,nthreads,0);else jtrdistx(jt,&c,0);
+  if(k==0&&n&1){D *zv=DAV(z); I mk,sh; INITD; D u2=sh?NEXTD1:NEXTD0; zv[n-1]=p[0]+p[1]*sqrt(-2.0*log(zv[n-1]))*cos(2*PI*u2);}  // the odd one
+ }else{
+  I nb=(n+RDBLK-1)/RDBLK;
+  if(jt->rngdata->rng==PXI){UI*v=jt->rngdata->rngv;
+   // each block gets a substream, named by a position in the main stream that is then skipped over so it will not be used again
+   c.key=v[0]; c.sd0=v[1]+1; v[1]+=nb; if(v[1]&7)pxrefill(v);
+  }else nthreads=1;  // other generators make one value after another
+  nthreads=MIN(nthreads,nb); c.pertask=(nb+nthreads-1)/nthreads; nthreads=(nb+c.pertask-1)/c.pertask;
+  if(nthreads>1)jtjobrun(jt,jtrdistx,&c,nthreads,0);else jtrdistx(jt,&c,0);
+ }
+ RETF(z);
+}
+
+F1(jtrandist1){R jtrandist2(jt,num(0),w);}
+
 // support for ?.
 // To the extent possible, ?. is frozen.  Changed modules need to be copied here to preserve compatibility
 #undef GMOF
@@ -290,13 +290,52 @@ static statusEnum insert(J jt, I key) {
 // *********************** end of red/black tree *************************
 // *********************** code for hashtable *************************
 
-static SB jtsbprobe(J,S,I,C*,I);
+// a string to look up: its bytes and byte length, the flag for the length of its characters as stored (c0) and for the minimum size needed (c2), and its hash
+typedef struct {C *s; I n; UI h; S c0, c2;} SBREQ;
 
-// insert symbol *s (length n) into the hash.  c0 is the flag for length of the characters as stored; c2 is the flag for the minimum required size
-// h is the hash for the string
-// result is symbol #, or 0+error if no space
-// This is called ONLY from stprobe
-static SB jtsbinsert(J jt,S c2,S c0,I n,C*s,UI h){I c,m,p,ui;SBU*u;
+// fill in the minimum character size and the hash of r->s.  Uses no table data, so needs no lock
+static void sbprep(SBREQ *r){I n=r->n; S c2=r->c0;
+ // set needed charsize for the input, which might be smaller than its storage class
+ if(SBC4&c2){C4*ss=(C4*)r->s; c2=c2&~SBC4; DQ(n>>2,if(65535<*ss){c2|=SBC4;break;}else if(127<*ss++){c2|=SBC2;});}
+ else if(SBC2&c2){US*ss=(US*)r->s;c2=c2&~SBC2; DQ(n>>1,if(127<*ss++){c2|=SBC2;break;});}
+ r->c2=c2;
+ // hash using c0 on original data
+ r->h=(r->c0&SBC4?hic4:r->c0&SBC2?hic2:hic)(n,(UC*)r->s);
+}
+
+// look in symbol table for the prepared string r.  The caller holds a lock on the tables.  Returns symbol# found, or -1 if not found
+static SB jtsbfind(J jt,SBREQ *r){B b;UC*t;I hi,ui;SBU*u;UI h=r->h;I n=r->n;C*s=r->s;UC*us=(UC*)s;S c0=r->c0;
+ hi=INITHASH(h);                               /* index into hash table        */
+ while(1){   // loop till empty hash slot or match
+  ui=IAV1(HASHTABLE)[hi];                    /* index into unique symbols    */
+  if(0>ui)R -1;  // not found
+  u=SBUV(ui);
+  if(h==u->h){         // test for a match on hash.  If it matches, then look at the string, length first
+   t=(UC*)SBSV(u->i);
+// string comparison ignores storage type
+//         c0  us  n                u->flag  t  u->n
+   switch((c0&SBC4?6:c0&SBC2?3:0)+(u->flag&SBC4?2:u->flag&SBC2?1:0)){
+// c0==0
+   case 1: if(n==u->n>>1){US*q=(US*)t;  b=1; DO(n,   if(us[i]!=q[i]){b=0; break;}); if(b)R ui;} break;
+   case 2: if(n==u->n>>2){C4*q=(C4*)t;  b=1; DO(n,   if(us[i]!=q[i]){b=0; break;}); if(b)R ui;} break;
+// c0==SBC2
+   case 3: if(n==u->n*2){US*q=(US*)us;               b=1; DO(n>>1, if(t[i]!=q[i]) {b=0; break;}); if(b)R ui;} break;
+   case 5: if(n==u->n>>1){US*q=(US*)us; C4*t1=(C4*)t; b=1; DO(n>>1, if(t1[i]!=q[i]){b=0; break;}); if(b)R ui;} break;
+// c0==SBC4
+   case 6: if(n==u->n*4){C4*q=(C4*)us;               b=1; DO(n>>2, if(t[i]!=q[i]) {b=0; break;}); if(b)R ui;} break;
+   case 7: if(n==u->n*2){C4*q=(C4*)us; US*t1=(US*)t; b=1; DO(n>>2, if(t1[i]!=q[i]){b=0; break;}); if(b)R ui;} break;
+// c0==u->flag
+   case 4:
+   case 8:
+   case 0: if(n==u->n&&!memcmpne(t,s,n))R ui; break;
+   }
+  }
+  if(unlikely(--hi<0))hi+=AN(HASHTABLE);
+ }
+}
+
+// insert the prepared string r into the hash.  result is symbol #, or 0+error if no space
+static SB jtsbinsert(J jt,SBREQ *r){I c,m,p;SBU*u;S c2=r->c2,c0=r->c0;I n=r->n;C*s=r->s;UI h=r->h;
 // optimize storage if ascii or short
  // We need a write lock since we are modifying the table.  Then look to see if the tables need to be extended
  WRITELOCK(JT(jt,sblock));
@@ -313,7 +352,7 @@ static SB jtsbinsert(J jt,S c2,S c0,I n,C*s,UI h){I c,m,p,ui;SBU*u;
   AM(HASHTABLE)=1; // set 'table not resized' for next time
  }
  // While we were waiting for write locks, someone else may have filled in the symbol.  It wouldn't do to have duplicates
- if((c=sbprobe(c0,n,s,2))>=0)goto exit;  // look again, under lock
+ if((c=sbfind(r))>=0)goto exit;  // look again, under lock
 // c2 new flag; c0 original flag
  if(c2!=c0)n>>=(c0&SBC4&&!c2&SBC2)?2:1;   // reduce the #bytes needed if the minimum size is less than the actual
  c=AM(JT(jt,sbu));                            /* cardinality                  */
@@ -343,58 +382,52 @@ exit: ;
 }    /* insert new symbol */
 
 // look in symbol table for string *s of length n bytes.  Returns symbol# found.  If not found, action depends on 'test':
-// if bit 0 set, just returns -1; otherwise inserts the symbol and returns the symbol# found
-// bit 1 of 'test' is set if this call is from sbinsert, and we already have a write lock on the tables
+// if set, just returns -1; otherwise inserts the symbol and returns the symbol# found
 // c2 is 0/1/2 indicating input is 1/2/4-byte chars
-static SB jtsbprobe(J jt,S c2,I n,C*s,I test){B b;UC*t;I hi,ui;SBU*u;UI h;UC*us=(UC*)s;
+static SB jtsbprobe(J jt,S c2,I n,C*s,I test){SBREQ r;I ui;
  if(!n)R(SB)0;   // sentinel
-// optimize storage if ascii or short
- S c0=c2;  // save original flag
- // set needed charsize for the input, which might be smaller than its storage class
- if(SBC4&c2){C4*ss=(C4*)s;     c2=c2&~SBC4; DQ(n>>2,if(65535<*ss){c2|=SBC4;break;}else if(127<*ss++){c2|=SBC2;});}
- else if(SBC2&c2){US*ss=(US*)s;c2=c2&~SBC2; DQ(n>>1,if(127<*ss++){c2|=SBC2;break;});}
-
-// hash using c0 on original data
- h=(c0&SBC4?hic4:c0&SBC2?hic2:hic)(n,us);
-
- // lock the table while we are reading from it, unless we already have a lock
- if(!(test&2))READLOCK(JT(jt,sblock)); 
- hi=INITHASH(h);                               /* index into hash table        */
- while(1){   // loop till empty hash slot or match
-  ui=IAV1(HASHTABLE)[hi];                    /* index into unique symbols    */
-  if(0>ui){if(test){ui=-1; goto exit;} READUNLOCK(JT(jt,sblock)); R sbinsert(c2,c0,n,s,h);} //  not found: normally go insert, but if test mode, return -1
-  u=SBUV(ui);
-  if(h==u->h){         // test for a match on hash.  If it matches, then look at the string, length first
-   t=(UC*)SBSV(u->i);
-// string comparison ignores storage type
-//         c0  us  n                u->flag  t  u->n
-   switch((c0&SBC4?6:c0&SBC2?3:0)+(u->flag&SBC4?2:u->flag&SBC2?1:0)){
-// c0==0
-   case 1: if(n==u->n>>1){US*q=(US*)t;  b=1; DO(n,   if(us[i]!=q[i]){b=0; break;}); if(b)goto exit;} break;
-   case 2: if(n==u->n>>2){C4*q=(C4*)t;  b=1; DO(n,   if(us[i]!=q[i]){b=0; break;}); if(b)goto exit;} break;
-// c0==SBC2
-   case 3: if(n==u->n*2){US*q=(US*)us;               b=1; DO(n>>1, if(t[i]!=q[i]) {b=0; break;}); if(b)goto exit;} break;
-   case 5: if(n==u->n>>1){US*q=(US*)us; C4*t1=(C4*)t; b=1; DO(n>>1, if(t1[i]!=q[i]){b=0; break;}); if(b)goto exit;} break;
-// c0==SBC4
-   case 6: if(n==u->n*4){C4*q=(C4*)us;               b=1; DO(n>>2, if(t[i]!=q[i]) {b=0; break;}); if(b)goto exit;} break;
-   case 7: if(n==u->n*2){C4*q=(C4*)us; US*t1=(US*)t; b=1; DO(n>>2, if(t1[i]!=q[i]){b=0; break;}); if(b)goto exit;} break;
-// c0==u->flag
-   case 4:
-   case 8:
-   case 0: if(n==u->n&&!memcmpne(t,s,n))goto exit; break;
-   }
-  }
-  if(unlikely(--hi<0))hi+=AN(HASHTABLE);
- }
-exit: ;
- if(!(test&2))READUNLOCK(JT(jt,sblock));  // release lock if we took one
+ r.s=s; r.n=n; r.c0=c2; sbprep(&r);
+ // lock the table while we are reading from it
+ READLOCK(JT(jt,sblock)); ui=sbfind(&r); READUNLOCK(JT(jt,sblock));
+ if(0>ui&&!test)R sbinsert(&r);  //  not found: normally go insert, but if test mode, return -1
  R ui;
 }   /* insert new symbol or get existing symbol */
 
+// Bulk lookup for the s: conversions.  The strings are divided among the threads of threadpool 0; each task hashes its strings with no lock, then
+// looks them all up under one read lock, which the tasks share.  Strings that are not found are then inserted in order, so the symbol numbers
+// are what one-at-a-time lookup would give
+typedef struct {SBREQ *r; SB *zv; I n, pertask;} SBBULK;
+
+static unsigned char jtsbprobex(J jt,void *ctx,UI4 ti){SBBULK *c=ctx;
+ I b=ti*c->pertask, e=MIN(b+c->pertask,c->n); SBREQ *r=c->r+b; SB *zv=c->zv+b;
+ DO(e-b, if(r[i].n)sbprep(&r[i]);)
+ READLOCK(JT(jt,sblock)) DO(e-b, zv[i]=r[i].n?sbfind(&r[i]):0;) READUNLOCK(JT(jt,sblock))
+ R 0;
+}
+
+#define SBMINSTRINGS 4096  // TUNE don't start a task for fewer strings than this
+// look up the m strings in r, inserting the new ones, and put their symbols in zv.  Result is 0 if error
+static B jtsbprobemany(J jt,SBREQ *r,I m,SB *zv){SBBULK c;
+ if(!m)R 1;
+ c.r=r; c.zv=zv; c.n=m;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(SBMINSTRINGS-m))>=0)nthreads=1;  // one thread or a small job
+ c.pertask=(m+nthreads-1)/nthreads; nthreads=(m+c.pertask-1)/c.pertask;
+ if(nthreads>1)jtjobrun(jt,jtsbprobex,&c,nthreads,0);else jtsbprobex(jt,&c,0);
+ DO(m, if(0>zv[i]){zv[i]=sbinsert(&r[i]); if(unlikely(jt->jerr!=0))R 0;})
+ R 1;
+}
+
+// allocate space for m requests
+#define GASBREQ(r,m) {A t_; GATV0(t_,INT,((m)*sizeof(SBREQ)+SZI-1)>>LGSZI,1); r=(SBREQ*)IAV1(t_);}
+
 // **************************** end of hashtable code *********************
 // **************************** start of s: functions *********************
 
-static A jtsbunstr(J jt,I q,A w){A z;S c2;I i,j,m,wn;SB*zv;
+// add the string at p, l bytes, to the requests at r
+#define SBREQ1(p,l) {r->s=(C*)(p); r->n=(l); r->c0=c2; ++r;}
+
+static A jtsbunstr(J jt,I q,A w){A z;S c2;I i,j,m,wn;SB*zv;SBREQ*r,*r0;
  ARGCHK1(w);
  if(!AN(w))R vec(SBT,0L,0L);
  ASSERT(AT(w)&LIT+C2T+C4T,EVDOMAIN);
@@ -404,26 +437,27 @@ static A jtsbunstr(J jt,I q,A w){A z;S c2;I i,j,m,wn;SB*zv;
  if(c2&SBC4){C4 c,*wv=C4AV(w); 
   c=wv[q==-1?0:wn-1];
   m=0; DO(wn, m+=c==wv[i];);
-  GATV0(z,SBT,m,1); zv=SBAV(z);
-  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){RE(*zv++=sbprobe(c2,4*(i-j),(C*)(j+wv),0)); j=i+1;}}
-  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){RE(*zv++=sbprobe(c2,4*(i-j),(C*)(j+wv),0)); j=i+1;}}
+  GATV0(z,SBT,m,1); zv=SBAV(z); GASBREQ(r0,m); r=r0;
+  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){SBREQ1(j+wv,4*(i-j)) j=i+1;}}
+  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){SBREQ1(j+wv,4*(i-j)) j=i+1;}}
  }else if(c2&SBC2){US c,*wv=USAV(w); 
   c=wv[q==-1?0:wn-1];
   m=0; DO(wn, m+=c==wv[i];);
-  GATV0(z,SBT,m,1); zv=SBAV(z);
-  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){RE(*zv++=sbprobe(c2,2*(i-j),(C*)(j+wv),0)); j=i+1;}}
-  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){RE(*zv++=sbprobe(c2,2*(i-j),(C*)(j+wv),0)); j=i+1;}}
+  GATV0(z,SBT,m,1); zv=SBAV(z); GASBREQ(r0,m); r=r0;
+  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){SBREQ1(j+wv,2*(i-j)) j=i+1;}}
+  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){SBREQ1(j+wv,2*(i-j)) j=i+1;}}
  }else{C c,*wv=CAV(w); 
   c=wv[q==-1?0:wn-1];
   m=0; DO(wn, m+=c==wv[i];);
-  GATV0(z,SBT,m,1); zv=SBAV(z);
-  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){RE(*zv++=sbprobe(c2,i-j,j+wv,0)); j=i+1;}}
-  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){RE(*zv++=sbprobe(c2,i-j,j+wv,0)); j=i+1;}}
+  GATV0(z,SBT,m,1); zv=SBAV(z); GASBREQ(r0,m); r=r0;
+  if(q==-1){for(i=j=1;i<=wn;++i)if(c==wv[i]||i==wn){SBREQ1(j+wv,i-j) j=i+1;}}
+  else     {for(i=j=0;i< wn;++i)if(c==wv[i]       ){SBREQ1(j+wv,i-j) j=i+1;}}
  }
+ RZ(sbprobemany(r0,m,zv));
  R z;
 }    /* monad s: on leading (_1=q) or trailing (_2=q) character separated strings */
 
-static A jtsbunlit(J jt,C cx,A w){A z;S c2;I i,m,wc,wr,*ws;SB*zv;
+static A jtsbunlit(J jt,C cx,A w){A z;S c2;I i,m,wc,wr,*ws;SB*zv;SBREQ*r,*r0;
  ARGCHK1(w);
  ASSERT(!AN(w)||AT(w)&LIT+C2T+C4T,EVDOMAIN);
  ASSERT(0<AR(w),EVRANK);
@@ -431,37 +465,40 @@ static A jtsbunlit(J jt,C cx,A w){A z;S c2;I i,m,wc,wr,*ws;SB*zv;
  wr=AR(w); ws=AS(w); wc=ws[wr-1];
  PRODX(m,wr-1,ws,1);
  GATV(z,SBT,m,wr-1,ws); zv=SBAV(z);
- if(!wc)mvc(m*sizeof(SB),zv,1,MEMSET00);
- else if(c2&SBC4){C4 c=(C4)cx,*s,*wv=C4AV(w);
+ if(!wc){mvc(m*sizeof(SB),zv,1,MEMSET00); R z;}
+ GASBREQ(r0,m); r=r0;
+ if(c2&SBC4){C4 c=(C4)cx,*s,*wv=C4AV(w);
   for(i=0;i<m;++i){
    s=wc+wv; DQ(wc, if(c!=*--s)break;);   /* exclude trailing "blanks"    */
-   RE(*zv++=sbprobe(c2,4*((c!=*s)+s-wv),(C*)wv,0));
+   SBREQ1(wv,4*((c!=*s)+s-wv))
    wv+=wc;
  }}else if(c2&SBC2){US c=(US)cx,*s,*wv=USAV(w);
   for(i=0;i<m;++i){
    s=wc+wv; DQ(wc, if(c!=*--s)break;);   /* exclude trailing "blanks"    */
-   RE(*zv++=sbprobe(c2,2*((c!=*s)+s-wv),(C*)wv,0));
+   SBREQ1(wv,2*((c!=*s)+s-wv))
    wv+=wc;
  }}else{C c=cx,*s,*wv=CAV(w);
   for(i=0;i<m;++i){
    s=wc+wv; DQ(wc, if(c!=*--s)break;);   /* exclude trailing "blanks"    */
-   RE(*zv++=sbprobe(c2,(c!=*s)+s-wv,wv,0));
+   SBREQ1(wv,(c!=*s)+s-wv)
    wv+=wc;
  }}
+ RZ(sbprobemany(r0,m,zv));
  R z;
 }    /* each row of literal array w less the trailing "blanks" is a symbol */
 
-static F1(jtsbunbox){A*wv,x,z;S c2;I i,m,n;SB*zv;
+static F1(jtsbunbox){A*wv,x,z;S c2;I i,m,n;SB*zv;SBREQ*r,*r0;
  ARGCHK1(w);
  ASSERT(!AN(w)||BOX&AT(w),EVDOMAIN);
  m=AN(w); wv=AAV(w); 
- GATV(z,SBT,m,AR(w),AS(w)); zv=SBAV(z);
+ GATV(z,SBT,m,AR(w),AS(w)); zv=SBAV(z); GASBREQ(r0,m); r=r0;
  for(i=0;i<m;++i){
   x=C(wv[i]); n=AN(x); c2=AT(x)&C4T?SBC4:AT(x)&C2T?SBC2:0; 
   ASSERT(!n||AT(x)&LIT+C2T+C4T,EVDOMAIN);
   ASSERT(1>=AR(x),EVRANK);
-  RE(*zv++=sbprobe(c2,c2&SBC4?(4*n):c2&SBC2?(2*n):n,CAV(x),0));
+  SBREQ1(CAV(x),c2&SBC4?(4*n):c2&SBC2?(2*n):n)
  }
+ RZ(sbprobemany(r0,m,zv));
  R z;
 }    /* each element of boxed array w is a string */
 
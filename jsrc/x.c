@@ -142,6 +142,20 @@ void jtforeigninit(J jt){UI i;
  MN(128,11) XPRIM(VERB, 0,           jtlrtrim,     VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
  MN(128,12) XPRIM(VERB, 0,           jtekupdate,     VASGSAFE|VJTFLGOK2,VF2WILLOPEN2A,RMAX,RMAX,RMAX);
  MN(128,13) XPRIM(VERB, jtfindspr, 0,                VASGSAFE|VJTFLGOK2,VF2WILLOPEN2A,RMAX,RMAX,RMAX);
+ MN(128,14) XPRIM(VERB, jtcsvsplit1,  jtcsvsplit2,  VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,15) XPRIM(VERB, jtrowgrade1,  jtrowgrade2,  VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,16) XPRIM(VERB, jtrowindex1,  jtrowindex2,  VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,17) XPRIM(ADV,  jtdictcreate, jtvalenceerr, VASGSAFE,VF2NONE,0L,  0L,  0L  );
+ MN(128,18) XPRIM(ADV,  jtixcreate,   jtvalenceerr, VASGSAFE,VF2NONE,0L,  0L,  0L  );
+ MN(128,19) XPRIM(VERB, jtfft1,       jtfft2,       VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,20) XPRIM(VERB, jtbitpack1,   jtbitunpack2, VASGSAFE,VF2NONE,1,   0,   1   );
+ MN(128,21) XPRIM(VERB, jtbitcount1,  jtbitcopy2,   VASGSAFE,VF2NONE,1,   1,   RMAX);
+ MN(128,22) XPRIM(VERB, jtbitindex1,  jtbitfrom2,   VASGSAFE,VF2NONE,1,   RMAX,1   );
+ MN(128,23) XPRIM(VERB, jtlpsolve,    0,            VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,24) XPRIM(VERB, jtrandist1,   jtrandist2,   VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,25) XPRIM(VERB, jthashfinal,  jthashupdate, VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,26) XPRIM(VERB, jtxxhash1,    jtxxhash2,    VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
+ MN(128,27) XPRIM(ADV,  jtbitlogic,   jtvalenceerr, VASGSAFE,VF2NONE,0L,  0L,  0L  );
 
 // infrequently-used fns follow
 
@@ -341,7 +355,7 @@ void jtforeigninit(J jt){UI i;
  MN(128,1) XPRIM(VERB, jtrinv,       0,            VASGSAFE,VF2NONE,2,   RMAX,RMAX);
  MN(128,3) XPRIM(VERB, jtcrc1,       jtcrc2,       VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
  MN(128,4) XPRIM(VERB, jtrngraw,     0,            VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
- MN(128,6) XPRIM(VERB, jtshasum1,    jtshasum2,    VASGSAFE,VF2NONE,1,1,RMAX);
+ MN(128,6) XPRIM(VERB, jtshasum1,    jtshasum2,    VASGSAFE,VF2NONE,RMAX,1,RMAX);
  MN(128,7) XPRIM(VERB, 0,            jtaes2,       VASGSAFE,VF2NONE,RMAX,RMAX,RMAX);
  MN(128,8) XPRIM(VERB, jtqhash12,    jtqhash12,    VASGSAFE|VJTFLGOK1|VJTFLGOK2,VF2NONE,RMAX,RMAX,RMAX);  
  MN(128,10) XPRIM(VERB, jtludecomp,         0,     VASGSAFE,VF2NONE,RMAX,   RMAX,RMAX);
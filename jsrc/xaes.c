@@ -26,22 +26,115 @@ int aes_sse2(I decrypt,I mode,UC *key,I keyn,UC* iv,UC* out,I n);
 int aes_arm(I decrypt,I mode,UC *key,I keyn,UC* iv,UC* out,I n);
 #endif
 
+#if !defined(ANDROID) && (defined(__i386__) || defined(_M_X64) || defined(__x86_64__))
+void ghash_ni(UC* y,UC* h,UC* p,I nb);
+#endif
+
+// encrypt/decrypt the n bytes at out in place, with the best code for this machine.  Nonzero if error
+static int aesbuf(I decrypt,I mode,UC *key,I keyn,UC* iv,UC* out,I n){
+#if (defined(__i386__) || defined(_M_X64) || defined(__x86_64__))
+#if !defined(ANDROID)
+  if(hwaes)R aes_ni(decrypt,mode,key,keyn,iv,out,n);
+#endif
+#if defined(__SSE2__)
+  R aes_sse2(decrypt,mode,key,keyn,iv,out,n);
+#else
+  R aes_c(decrypt,mode,key,keyn,iv,out,n);
+#endif
+#else
+#if defined(__aarch64__)
+  if(hwaes)R aes_arm(decrypt,mode,key,keyn,iv,out,n);
+#endif
+  R aes_c(decrypt,mode,key,keyn,iv,out,n);
+#endif
+}
+
+// GHASH of GCM without carry-less multiply: 4 bits of the multiplier at a time, from a table of the multiples of h
+static const US last4[16]={0x0000,0x1c20,0x3840,0x2460,0x7080,0x6ca0,0x48c0,0x54e0,0xe100,0xfd20,0xd940,0xc560,0x9180,0x8da0,0xa9c0,0xb5e0};
+static UI be64(UC *p){UI r=0; DO(8, r=(r<<8)|p[i];) R r;}
+static void stbe64(UC *p,UI v){DQ(8, p[i]=(UC)v; v>>=8;)}
+static void ghash_c(UC *y,UC *h,UC *p,I nb){UI hh[16],hl[16],vh=be64(h),vl=be64(h+8),zh,zl;
+  hh[0]=hl[0]=0; hh[8]=vh; hl[8]=vl;
+  for(I i=4;i>0;i>>=1){UI t=(vl&1)*0xe1000000; vl=(vh<<63)|(vl>>1); vh=(vh>>1)^(t<<32); hh[i]=vh; hl[i]=vl;}
+  for(I i=2;i<=8;i*=2){vh=hh[i]; vl=hl[i]; for(I j=1;j<i;j++){hh[i+j]=vh^hh[j]; hl[i+j]=vl^hl[j];}}
+  UC x[16]; MC(x,y,16);
+  for(;nb;--nb,p+=16){
+    DO(16, x[i]^=p[i];)
+    zh=hh[x[15]&0xf]; zl=hl[x[15]&0xf];
+    for(I i=15;i>=0;i--){I lo=x[i]&0xf, hi=x[i]>>4, rem;
+      if(i!=15){rem=zl&0xf; zl=(zh<<60)|(zl>>4); zh=(zh>>4)^((UI)last4[rem]<<48)^hh[lo]; zl^=hl[lo];}
+      rem=zl&0xf; zl=(zh<<60)|(zl>>4); zh=(zh>>4)^((UI)last4[rem]<<48)^hh[hi]; zl^=hl[hi];
+    }
+    stbe64(x,zh); stbe64(x+8,zl);
+  }
+  MC(y,x,16);
+}
+
+// y = GHASH of y followed by the nb blocks at p
+static void ghash(UC *y,UC *h,UC *p,I nb){
+#if !defined(ANDROID) && (defined(__i386__) || defined(_M_X64) || defined(__x86_64__))
+  if(hwaes&&(getCpuFeatures()&CPU_X86_FEATURE_PCLMUL)){ghash_ni(y,h,p,nb); R;}
+#endif
+  ghash_c(y,h,p,nb);
+}
+
+// z = a*b in the GCM field
+static void gfmul(UC *z,UC *a,UC *b){UC t[16]; mvc(16,t,1,MEMSET00); ghash(t,b,a,1); MC(z,t,16);}
+
+// z = h^k in the GCM field, k>0
+static void gfpow(UC *z,UC *h,I k){UC p[16]; MC(p,h,16); MC(z,h,16); for(--k;k;k>>=1){if(k&1)gfmul(z,z,p); gfmul(p,p,p);}}
+
+// add k to the 128-bit big-endian counter iv
+static void ctradd(UC *iv,UI k){UI lo=be64(iv+8), hi=be64(iv); hi+=(lo+k)<lo; lo+=k; stbe64(iv,hi); stbe64(iv+8,lo);}
+
+// The blocks are divided among the threads of threadpool 0 for every mode but CBC encryption, where each block needs the one before.
+// Each task has its own starting iv: the running counter for CTR/GCM, the preceding ciphertext block for CBC.
+// For GCM each task also hashes its ciphertext, starting from 0; the partial hashes are combined afterwards
+typedef struct {
+  I decrypt,mode,keyn;
+  UC *key,*out;
+  I nb,blockspertask;  // number of 16-byte blocks, number for each task
+  I gcmn;  // GCM: number of bytes of message; the rest of the last block is hashed as 0
+  UC *ivs;  // 16 bytes of starting iv for each task
+  UC *h,*y;  // GCM: hash key; 16 bytes of partial hash for each task
+  I err;
+} AESCTX;
+
+#define GCMPIECE 4096  // blocks encrypted and hashed together, to stay in cache
+static unsigned char jtaesx(J jt,void *ctx,UI4 ti){AESCTX *c=ctx;
+  I b=ti*c->blockspertask, e=MIN(b+c->blockspertask,c->nb); UC *iv=c->ivs+16*ti;
+  if(b>=e)R 0;
+  if(c->mode!=3){if(aesbuf(c->decrypt,c->mode,c->key,c->keyn,iv,c->out+16*b,16*(e-b)))c->err=1; R 0;}
+  UC *y=c->y+16*ti; mvc(16,y,1,MEMSET00);
+  for(I i=b;i<e;i+=GCMPIECE){I k=MIN(GCMPIECE,e-i); UC *p=c->out+16*i;
+    if(c->decrypt)ghash(y,c->h,p,k);
+    if(aesbuf(0,2,c->key,c->keyn,iv,p,16*k))c->err=1;
+    ctradd(iv,k);
+    if(!c->decrypt){I t=16*(i+k)-c->gcmn; if(t>0)mvc(t,p+16*k-t,1,MEMSET00); ghash(y,c->h,p,k);}
+  }
+  R 0;
+}
+
 /*
   mode
   0    ECB
   1    CBC
   2    CTR
+  3    GCM
  */
+#define AESMINBYTES 262144  // TUNE don't start a task for fewer bytes than this
 DF2(jtaes2)
 {
-  I n,decrypt,keyn,mode=1;
-  int n1,padding=1;
-  A z,*av,dec;
-  UC *out,*key,*iv;
+  I n,decrypt,keyn,mode=1,gcmn=0;
+  int n1=0,padding=1;
+  A z,*av,dec,t;
+  UC *out,*key,*iv,*aad=0,gh[16],gy[16],j0[16];
+  I aadn=0;
+  AESCTX c;
   F2RANK(1,1,jtaes2,self);  // do rank loop if necessary
   ASSERT(AT(a)&BOX,EVDOMAIN);
   ASSERT(1>=AR(a),EVRANK);
-  ASSERT(AN(a)>=3&&AN(a)<=4,EVLENGTH);
+  ASSERT(AN(a)>=3&&AN(a)<=5,EVLENGTH);
   av=AAV(a);
   ASSERT(1>=AR(C(av[0])),EVRANK);
   RE(dec=vi(C(av[0])));
@@ -56,70 +149,96 @@ DF2(jtaes2)
   ASSERT(AT(C(av[2]))&LIT,EVDOMAIN);
   ASSERT(1>=AR(C(av[2])),EVRANK);
   iv=UAV(C(av[2]));
-  ASSERT(AN(C(av[2]))==16,EVDOMAIN);
   if(AN(a)>3) {
     ASSERT(AT(C(av[3]))&LIT,EVDOMAIN);
     ASSERT(1>=AR(C(av[3])),EVRANK);
     ASSERT(3==AN(C(av[3]))||9==AN(C(av[3])),EVDOMAIN);
     if(3==AN(C(av[3]))) {
-      mode=(!strncasecmp(CAV(C(av[3])),"ECB",AN(C(av[3]))))?0:(!strncasecmp(CAV(C(av[3])),"CBC",AN(C(av[3]))))?1:(!strncasecmp(CAV(C(av[3])),"CTR",AN(C(av[3]))))?2:-1;
+      mode=(!strncasecmp(CAV(C(av[3])),"ECB",AN(C(av[3]))))?0:(!strncasecmp(CAV(C(av[3])),"CBC",AN(C(av[3]))))?1:(!strncasecmp(CAV(C(av[3])),"CTR",AN(C(av[3]))))?2:(!strncasecmp(CAV(C(av[3])),"GCM",AN(C(av[3]))))?3:-1;
     } else {
       padding=0;
       mode=(!strncasecmp(CAV(C(av[3])),"ECB NOPAD",AN(C(av[3]))))?0:(!strncasecmp(CAV(C(av[3])),"CBC NOPAD",AN(C(av[3]))))?1:(!strncasecmp(CAV(C(av[3])),"CTR NOPAD",AN(C(av[3]))))?2:-1;
     }
     ASSERT(mode!=-1,EVDOMAIN);
   }
+  ASSERT(AN(C(av[2]))==(mode==3?12:16),EVDOMAIN);  // GCM takes the 96-bit iv
+  if(AN(a)>4) {  // additional authenticated data, GCM only
+    ASSERT(mode==3,EVLENGTH);
+    ASSERT(!AN(C(av[4]))||AT(C(av[4]))&LIT,EVDOMAIN);
+    ASSERT(1>=AR(C(av[4])),EVRANK);
+    aad=UAV(C(av[4])); aadn=AN(C(av[4]));
+  }
   n=AN(w);
   ASSERT(!n||AT(w)&LIT,EVDOMAIN);
   ASSERT(!n||1>=AR(w),EVRANK);
-  if(decrypt) {
-    ASSERT(n||!padding,EVLENGTH);
-    ASSERT(!n||0==n%16,EVLENGTH);
+  if(mode==3) {
+    // GCM is a stream cipher: the message is not padded, and the 16-byte tag follows the ciphertext
+    if(decrypt)ASSERT(n>=16,EVLENGTH);
+    gcmn=n-16*decrypt;
+    ASSERT(gcmn<=16*(((I)1<<32)-2),EVLIMIT);
+    n=(gcmn+15)&-16;
+    GATV0(z,LIT,n+16,1);
+    padding=0;
   } else {
-    if(!(n1=n%16)&&padding)n+=16;
-    if(n1)n+=16-n1;
+    if(decrypt) {
+      ASSERT(n||!padding,EVLENGTH);
+      ASSERT(!n||0==n%16,EVLENGTH);
+    } else {
+      if(!(n1=n%16)&&padding)n+=16;
+      if(n1)n+=16-n1;
+    }
+    ASSERT(0==(n%16),EVDOMAIN);
+    GATV0(z,LIT,n,1);
   }
-  ASSERT(0==(n%16),EVDOMAIN);
-  GATV0(z,LIT,n,1);
   out=UAV(z);
-  if(!n)R z;
-  MC(out,CAV(w),AN(w));
+  if(!n&&mode!=3)R z;
+  MC(out,CAV(w),mode==3?gcmn:AN(w));
+  if(mode==3)mvc(AN(z)-gcmn,out+gcmn,1,MEMSET00);
   if(!decrypt) {
     if(padding) {
       if(n1)mvc(16-n1,out+n-(16-n1),1,iotavec-IOTAVECBEGIN+(16-n1));
       else mvc(16,out+n-16,1,iotavec-IOTAVECBEGIN+(16));
-    } else if(n1)mvc(16-n1,out+n-(16-n1),1,MEMSET00);
-  }
-#if (defined(__i386__) || defined(_M_X64) || defined(__x86_64__))
-#if !defined(ANDROID)
-  if(hwaes) {
-    ASSERT(!aes_ni(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-  } else {
-#if defined(__SSE2__)
-    ASSERT(!aes_sse2(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-#else
-    ASSERT(!aes_c(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-#endif
+    } else if(mode!=3&&n1)mvc(16-n1,out+n-(16-n1),1,MEMSET00);
   }
-#else
-/* ANDROID x86 */
-#if defined(__SSE2__)
-  ASSERT(!aes_sse2(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-#else
-  ASSERT(!aes_c(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-#endif
-#endif
-#else
-#if defined(__aarch64__)
-  if(hwaes) {
-    ASSERT(!aes_arm(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-  } else {
-    ASSERT(!aes_c(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
+  memset(&c,0,sizeof(c));
+  c.decrypt=decrypt; c.mode=mode; c.key=key; c.keyn=keyn; c.out=out; c.nb=n>>4; c.gcmn=gcmn;
+  // divide the blocks among the threads
+  I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+  if(((1-c.nb)&(1-nthreads)&(AESMINBYTES-n))>=0||(mode==1&&!decrypt))nthreads=1;  // if one block, one thread, a small job, or CBC encryption, use one thread
+  nthreads=MAX(1,MIN(nthreads,c.nb)); c.blockspertask=(c.nb+nthreads-1)/nthreads;
+  GATV0(t,LIT,32*nthreads,1); c.ivs=UAV(t); c.y=c.ivs+16*nthreads;
+  if(mode==3) {
+    // hash key H=E(0); J0=iv,1 encrypts the tag; the message is CTR from J0+1
+    mvc(16,gh,1,MEMSET00); ASSERT(!aesbuf(0,0,key,keyn,gh,gh,16),EVDOMAIN); c.h=gh;
+    MC(j0,iv,12); j0[12]=j0[13]=j0[14]=0; j0[15]=1; ASSERT(!aesbuf(0,0,key,keyn,j0,j0,16),EVDOMAIN);
+    MC(c.ivs,iv,12); c.ivs[12]=c.ivs[13]=c.ivs[14]=0; c.ivs[15]=2;
+  } else MC(c.ivs,iv,16);
+  DO(nthreads-1, UC *v=c.ivs+16*(i+1); I b=(i+1)*c.blockspertask;
+    if(mode>=2){MC(v,c.ivs,16); ctradd(v,b);}  // counter at the start of the task
+    else if(mode==1&&b<=c.nb)MC(v,out+16*(b-1),16);  // CBC: the preceding ciphertext block, captured before it is decrypted
+  )
+  if(nthreads>1)jtjobrun(jt,jtaesx,&c,nthreads,0);else jtaesx(jt,&c,0);
+  ASSERT(!c.err,EVDOMAIN);
+  if(mode==3) {
+    // combine: hash the aad, then each task's part S = (S*H^k) ^ y, then the lengths in bits
+    UC lens[16];
+    mvc(16,gy,1,MEMSET00);
+    if(aadn){ghash(gy,gh,aad,aadn>>4); if(aadn&15){UC l[16]; mvc(16,l,1,MEMSET00); MC(l,aad+(aadn&-16),aadn&15); ghash(gy,gh,l,1);}}
+    for(I j=0;j<nthreads;++j){I b=j*c.blockspertask, k=MIN(b+c.blockspertask,c.nb)-b;
+      if(k>0){UC hk[16]; gfpow(hk,gh,k); gfmul(gy,gy,hk); DO(16, gy[i]^=c.y[16*j+i];)}
+    }
+    stbe64(lens,(UI)aadn<<3); stbe64(lens+8,(UI)gcmn<<3); ghash(gy,gh,lens,1);
+    DO(16, gy[i]^=j0[i];)
+    if(decrypt) {
+      // compare tags in constant time; on mismatch, release no plaintext
+      UC d=0; DO(16, d|=gy[i]^UAV(w)[gcmn+i];)
+      if(d){mvc(AN(z),out,1,MEMSET00); ASSERT(0,EVDOMAIN);}
+      AS(z)[0]=AN(z)=gcmn; mvc(n+16-gcmn,out+gcmn,1,MEMSET00);
+    } else {
+      MC(out+gcmn,gy,16); AS(z)[0]=AN(z)=gcmn+16; mvc(n-gcmn,out+gcmn+16,1,MEMSET00);
+    }
+    R z;
   }
-#else
-  ASSERT(!aes_c(decrypt,mode,key,keyn,iv,out,n),EVDOMAIN);
-#endif
-#endif
   if(decrypt&&padding) {
     int i;
     n1=out[n-1];
@@ -757,6 +757,23 @@ F1(jtisnan){A*wv,z;B*u;D*v;I n,t;
 #define NANOS 1000000000LL
 #define SECS  86400
 
+// The conversions are independent for each row, so large arrays are divided among the threads of threadpool 0
+typedef struct {
+ C *wv; C *zv;  // input and result
+ I n, rowspertask;  // number of rows, number given to each task
+ I len;  // bytes per row: the string length, or the result line length for formatting
+ I prec, local;  // precision; nanoseconds to local timezone
+ UC decimalpt, zuluflag;
+} DTCTX;
+#define DTMINROWS 4096  // TUNE don't start a task for fewer rows than this
+
+static void dtrun(J jt,unsigned char (*f)(J,void*,UI4),DTCTX *c,I minrows){
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(minrows-c->n))>=0){c->rowspertask=c->n; f(jt,c,0); R;}  // if one thread or a small job, use one thread
+ c->rowspertask=(c->n+nthreads-1)/nthreads; nthreads=(c->n+c->rowspertask-1)/c->rowspertask;
+ jtjobrun(jt,f,c,nthreads,0);
+}
+
 // e from yyyymmddhhmnss.  The argument is assumed to be well-formed
 static I eft(I n,UI* e,UI* t)
 {
@@ -777,7 +794,7 @@ static I eft(I n,UI* e,UI* t)
   // Add in leap-years (since the year 0, for comp. ease).  Year 2000 eg, which starts Mar 1, is a leap year and has 1 added to its day#s (since they come after Feb 29)
   D+=Y>>2;
   // Gregorian correction.  Since it is very unlikely we will encounter a date that needs correcting, we use an IF
-  if((UI4)(Y-1901)>(UI4)(2100-1901)){  // date is outside 1901-2099
+  if((UI4)(Y-1901)>(UI4)(2099-1901)){  // date is outside 1901-2099
    D+=(((Y/100)>>2)-(Y/100))-((2000/400)-(2000/100));  // 1900 2100 2200 2300 2500 etc are NOT leapyears.  Create correction from Y2000 count
   }
   // Add in extra days for earlier 31-day months in this adjusted year (so add 0 in March)
@@ -792,6 +809,12 @@ static I eft(I n,UI* e,UI* t)
  return 0;
 }
 
+static unsigned char jteftx(J jt,void *ctx,UI4 ti){DTCTX *c=ctx;
+ I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->n);  // the block of rows for this task
+ eft(e-b,(UI*)c->zv+b,(UI*)c->wv+b);
+ R 0;
+}
+
 
 static const UC char2tbl[200] = {
 '0','0' , '0','1' , '0','2' , '0','3' , '0','4' , '0','5' , '0','6' , '0','7' , '0','8' , '0','9' ,
@@ -808,29 +831,16 @@ static const UC char2tbl[200] = {
 
 static const I nanopowers[9] = {100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
 
-// Convert nanosec to ISO8601
-// w is input array, decimalpt is character to use if there are fractional sec, zuluflag is timezone character
-// prec is -1 for date only, 0 for integer seconds, 1-9 for that many fractional seconds places
-// prec of 7*SZI-21 means 'produce 7 ints per input time'
-static A sfe(J jt,A w,I prec,UC decimalpt,UC zuluflag){
+// format rows of nanosecond times.  c->len is the result line length
+static unsigned char jtsfex(J jt,void *ctx,UI4 ti){DTCTX *c=ctx;
 #if SY_64
- UI k; UI4 ymd,E,N,M,HMS,d,j,g,m,t,y;I i;A z;  // unsigned for faster / %
- // Validate input.  We will accept FL input, but it's not going to have nanosecond precision
- RZ(w=vi(w));  // convert to INT
- // Figure out size of result. 10 for date, 9 for time, 1 for binary point (opt), 1 for each fractional digit (opt), 1 for timezone
- I linelen=(10+9)-(REPSGN(prec)&9)+prec+(prec!=0)+(zuluflag=='Z');  // bytes per line of result: 20, but 10 if no date, plus one per frac digit, plus decimal point if any frac digits, 1 if Z
-   // if we are running for 6!:15, linelen will come out 56 and the store will be 7 INTs
- // Allocate result area, one row per input value
- GATV0(z,LIT,AN(w)*linelen,AR(w)+1) MCISH(AS(z),AS(w),AR(w)) AS(z)[AR(w)]=linelen==7*SZI?7:linelen;
- // If the result will be INT, make it so
- if(linelen==56){AT(z)=INT; AN(z)>>=LGSZI;}
- if(AN(w)==0){RETF(z);}  // handle empty return
- I rows=AN(w);  // number of rows to process
- I *e=IAV(w);  // pointer to nanosecond data
- C *s=CAV(z);  // pointer to result
-
+ UI k; UI4 ymd,E,N,M,HMS,d,j,g,m,t,y;I i;  // unsigned for faster / %
+ I linelen=c->len; UC decimalpt=c->decimalpt, zuluflag=c->zuluflag;
+ I b=ti*c->rowspertask, rows=MIN(b+c->rowspertask,c->n);  // the block of rows for this task
+ I *e=(I*)c->wv;  // pointer to nanosecond data
+ C *s=c->zv+b*linelen;  // pointer to result
  // Loop for each time
- for(i=0;i<rows;++i, s+=linelen){
+ for(i=b;i<rows;++i, s+=linelen){
   // fetch the time.  If it is negative, add days amounting to the earliest allowed time so that the modulus calculations can always
   // be positive to get hmsn.  We will add the days back for all the day calculations, since they are in the Julian epoch anyway
   k= e[i] + (REPSGN(e[i])&(MIND*(I)24*(I)3600*(I)NANOS));  // ymdHMSN
@@ -882,110 +892,191 @@ static A sfe(J jt,A w,I prec,UC decimalpt,UC zuluflag){
    ((I*)s)[0]=y; ((I*)s)[1]=m; ((I*)s)[2]=d; ((I*)s)[3]=HMS; ((I*)s)[4]=M; ((I*)s)[5]=E; ((I*)s)[6]=N;
   }
  }
+#endif
+ R 0;
+}
+
+// Convert nanosec to ISO8601
+// w is input array, decimalpt is character to use if there are fractional sec, zuluflag is timezone character
+// prec is -1 for date only, 0 for integer seconds, 1-9 for that many fractional seconds places
+// prec of 7*SZI-21 means 'produce 7 ints per input time'
+static A sfe(J jt,A w,I prec,UC decimalpt,UC zuluflag){
+#if SY_64
+ A z;
+ // Validate input.  We will accept FL input, but it's not going to have nanosecond precision
+ RZ(w=vi(w));  // convert to INT
+ // Figure out size of result. 10 for date, 9 for time, 1 for binary point (opt), 1 for each fractional digit (opt), 1 for timezone
+ I linelen=(10+9)-(REPSGN(prec)&9)+prec+(prec!=0)+(zuluflag=='Z');  // bytes per line of result: 20, but 10 if no date, plus one per frac digit, plus decimal point if any frac digits, 1 if Z
+   // if we are running for 6!:15, linelen will come out 56 and the store will be 7 INTs
+ // Allocate result area, one row per input value
+ GATV0(z,LIT,AN(w)*linelen,AR(w)+1) MCISH(AS(z),AS(w),AR(w)) AS(z)[AR(w)]=linelen==7*SZI?7:linelen;
+ // If the result will be INT, make it so
+ if(linelen==56){AT(z)=INT; AN(z)>>=LGSZI;}
+ if(AN(w)==0){RETF(z);}  // handle empty return
+ DTCTX c={.wv=CAV(w), .zv=CAV(z), .n=AN(w), .len=linelen, .decimalpt=decimalpt, .zuluflag=zuluflag};
+ dtrun(jt,jtsfex,&c,DTMINROWS);
  RETF(z);
 #else
 R 0;
 #endif
 }
 
-
-// w is LIT array of ISO strings (rank>0, not empty), result is array of INTs with nanosecond time for each string
-// We don't bother to support a boxed-string version because the strings are shorter than the boxes & it is probably just about as good to just open the boxed strings
-// prec is -1 (day only) or 0,3,9 for that many fractional digits below seconds
-// if local is given we convert all UTC times to times in the 'local' zone, where local is in seconds
-static A efs(J jt,A w,I prec,I local){
-#if SY_64
- I i;A z;
- // Allocate result area
- I n; PROD(n,AR(w)-1,AS(w)); GATV(z,INT,n,AR(w)-1,AS(w))
- I strglen=AS(w)[AR(w)-1];
- C *s=CAV(w);  // point to start of first string
- UC afterday=(UC)((~prec)>>8);  //  0x00 if we stop  after the day, 0xff if we continue
- for(i=0;i<n;++i,s+=strglen){
-  UI4 Y,M,D,ss; I4 hh,mm;  // hh,mm are I because they may go negative during TZ adjustment
-  // It's OK to overfetch from a string buffer, as long as you don't rely on the contents fetched.  They're padded
-  // We will store an invalid byte on top of the character after the end of the string.  We'll be sure to restore it!
-  UC savesentinel = s[strglen]; s[strglen]=0;  // install end-of-string marker
-  UC *sp=s;  // scan pointer through the string
-  // Read/convert two-digit things.  Once we commit to reading digits, we fail if there aren't two of them; so check types first as needed
-  // We code this on the assumption that the format is constant throughout, and therefore branches will not be mispredicted after the first loop
-#define DOERR {IAV(z)[i]=IMIN; goto err;}
 #define ISDIGIT(d) (((UI4)d-(UI4)'0')<=((UI4)'9'-(UI4)'0'))
+// Fixed-layout check for the common ISO form YYYY-MM-DD[T ]HH:MM:SS, a word at a time.  dm has 0xff in the bytes that must be digits;
+// the other bytes of sv must match w exactly
+#define DTDIGITSOK(w,dm) ((((w)&(dm)&0xf0f0f0f0f0f0f0f0)==((dm)&0x3030303030303030)) & (((((w)&(dm))+((dm)&0x0606060606060606))&(dm)&0xf0f0f0f0f0f0f0f0)==((dm)&0x3030303030303030)))
+#define DTLAYOUTOK(w,dm,sv) (DTDIGITSOK(w,dm) & (((w)&~(dm))==(sv)))
+#define DTDATEDM 0x00ffff00ffffffff  // YYYY-MM-
+#define DTDATESV 0x2d00002d00000000
+#define DTTIMEDM 0xffff00ffff00ffff  // HH:MM:SS
+#define DTTIMESV 0x00003a00003a0000
+#if SY_64
+// the word loaded from 8 characters, first character in the low byte.  The layouts the fast path must take, and some it must refuse
+#define DTWORD(a,b,c,d,e,f,g,h) ((UI)(UC)(a)|(UI)(UC)(b)<<8|(UI)(UC)(c)<<16|(UI)(UC)(d)<<24|(UI)(UC)(e)<<32|(UI)(UC)(f)<<40|(UI)(UC)(g)<<48|(UI)(UC)(h)<<56)
+_Static_assert(DTLAYOUTOK(DTWORD('2','0','2','4','-','0','3','-'),DTDATEDM,DTDATESV),"date layout not recognized");
+_Static_assert(DTLAYOUTOK(DTWORD('1','9','9','9','-','1','2','-'),DTDATEDM,DTDATESV),"date layout not recognized");
+_Static_assert(DTLAYOUTOK(DTWORD('1','2',':','3','4',':','5','6'),DTTIMEDM,DTTIMESV),"time layout not recognized");
+_Static_assert(!DTLAYOUTOK(DTWORD('2','0','2','4','/','0','3','-'),DTDATEDM,DTDATESV),"date separator not checked");
+_Static_assert(!DTLAYOUTOK(DTWORD('2','0','2','4','-','0','3','1'),DTDATEDM,DTDATESV),"date separator not checked");
+_Static_assert(!DTLAYOUTOK(DTWORD('2','0',':','4','-','0','3','-'),DTDATEDM,DTDATESV),"date digits not checked");
+_Static_assert(!DTLAYOUTOK(DTWORD('1','2',':','3','4','.','5','6'),DTTIMEDM,DTTIMESV),"time separator not checked");
+_Static_assert(!DTLAYOUTOK(DTWORD('1','2',':','3','4',':','5','/'),DTTIMEDM,DTTIMESV),"time digits not checked");
+#endif
+#define TWOD(p) ((UI4)(p)[0]*10+(UI4)(p)[1]-(UI4)'0'*11)  // value of 2 digits at p
+
+// Convert one ISO string at s, which is followed by a 0 sentinel, to nanosecond time.  Result is IMIN if the string is invalid
+static I efs1(UC *s,I strglen,UC afterday,I prec,I local){
+ UI4 Y,M,D,ss; I4 hh,mm;  // hh,mm are I because they may go negative during TZ adjustment
+ UC *sp=s;  // scan pointer through the string
+ UI N=0;  // init nanosec accum to 0
+ UC c;
+ // Fast path for the layout we write and nearly every feed uses: validate the fixed part with two word compares and read the fields without
+ // per-character branches.  Fractional seconds and timezone are picked up by the general scan.  Anything irregular is rescanned from the start
+ if(strglen>=10){
+  UI wd=*(UI*)s;
+  if(DTLAYOUTOK(wd,DTDATEDM,DTDATESV)&ISDIGIT(s[8])&ISDIGIT(s[9])){
+   Y=100*TWOD(s)+TWOD(s+2); M=TWOD(s+5); D=TWOD(s+8);
+   if(((UI4)(Y-MINY)>(UI4)(MAXY-MINY))|((UI4)(M-1)>(UI4)(12-1))|((UI4)(D-1)>(UI4)(31-1)))R IMIN;
+   if(!(s[10]&afterday)){hh=mm=ss=0; goto gottime;}   // YYYY-MM-DD alone, or after-day ignored
+   if(strglen>=19){
+    UI wt=*(UI*)(s+11);
+    if(DTLAYOUTOK(wt,DTTIMEDM,DTTIMESV)&((s[10]=='T')|(s[10]==' '))){
+     hh=TWOD(s+11); mm=TWOD(s+14); ss=TWOD(s+17);
+     if(((UI4)hh>24)|((UI4)mm>59)|((UI4)ss>60))R IMIN;
+     sp=s+19; c=*sp; goto gotsec;
+    }
+   }
+  }
+ }
+ // General scan.  Read/convert two-digit things.  Once we commit to reading digits, we fail if there aren't two of them; so check types first as needed
+ // We code this on the assumption that the format is constant throughout, and therefore branches will not be mispredicted after the first loop
+#define DOERR R IMIN;
 // same, but use c for the first digit
 #define RDTWOC(z,min,max) if(!ISDIGIT(sp[1]))DOERR z=(UI4)c*10+((UI4)sp[1]-(UI4)'0')-((UI4)'0'*(UI4)10); if((UI4)(z-(min))>(UI4)((max)-(min)))DOERR sp+=2; c=*sp;
-  UI N=0;  // init nanosec accum to 0
-  // throughout this stretch we may have c set to 'next character'
-  UC c=*sp;
-  RDTWOC(Y,0,99); RDTWOC(M,0,99); Y=100*Y+M;  // fetch YYYY.  M is a temp
-  if((UI4)(Y-MINY)>(UI4)(MAXY-MINY))DOERR
-  if(!(c&~' ')){M=D=1; hh=mm=ss=0; goto gottime;}   // YYYY alone.  Default the rest
-  if(c=='T'){M=D=1; goto gotdate;}    // YYYYT.  Default MD
-  // normal case
-  if(c=='-')c=*++sp;  // skip '-' if present
-  RDTWOC(M,1,12);
-  if(!(c&~' ')){D=1; hh=mm=ss=0; goto gottime;}   // YYYY-MM alone.  Default the rest
-  if(c=='T'){D=1; goto gotdate;}    // YYYY-MMT.  Default D
-  if(c=='-')c=*++sp;  // skip '-' if present
-  RDTWOC(D,1,31);
-  if(!(c&afterday)){hh=mm=ss=0; goto gottime;}   // YYYY-MM-DD alone, or after-day ignored.  Default the rest.  space here is a delimiter
+ // throughout this stretch we may have c set to 'next character'
+ c=*sp;
+ RDTWOC(Y,0,99); RDTWOC(M,0,99); Y=100*Y+M;  // fetch YYYY.  M is a temp
+ if((UI4)(Y-MINY)>(UI4)(MAXY-MINY))DOERR
+ if(!(c&~' ')){M=D=1; hh=mm=ss=0; goto gottime;}   // YYYY alone.  Default the rest
+ if(c=='T'){M=D=1; goto gotdate;}    // YYYYT.  Default MD
+ // normal case
+ if(c=='-')c=*++sp;  // skip '-' if present
+ RDTWOC(M,1,12);
+ if(!(c&~' ')){D=1; hh=mm=ss=0; goto gottime;}   // YYYY-MM alone.  Default the rest
+ if(c=='T'){D=1; goto gotdate;}    // YYYY-MMT.  Default D
+ if(c=='-')c=*++sp;  // skip '-' if present
+ RDTWOC(D,1,31);
+ if(!(c&afterday)){hh=mm=ss=0; goto gottime;}   // YYYY-MM-DD alone, or after-day ignored.  Default the rest.  space here is a delimiter
 gotdate: ;
-  if((c=='T')|(c==' '))c=*++sp;  // Consume the T/sp if present.  It must be followed by HH.  sp as a separator is not ISO 8601
-  if(!(c&~' ')){hh=mm=ss=0; goto gottime;}   // YYYY-MM-DDTbb treat this as ending the year, default the rest
-  RDTWOC(hh,0,24);  // 24 allowed at midnight
-  if((c<0x40) & (((I)1<<'+')|((I)1<<'-')|((I)1<<' ')|((I)1<<0))>>c){mm=ss=0; if((c&~' '))goto hittz; goto gottime;}
-  if(c==':')c=*++sp;  // skip ':' if present
-  RDTWOC(mm,0,59);
-  if((c<0x40) & (((I)1<<'+')|((I)1<<'-')|((I)1<<' ')|((I)1<<0))>>c){ss=0; if((c&~' '))goto hittz; goto gottime;}
+ if((c=='T')|(c==' '))c=*++sp;  // Consume the T/sp if present.  It must be followed by HH.  sp as a separator is not ISO 8601
+ if(!(c&~' ')){hh=mm=ss=0; goto gottime;}   // YYYY-MM-DDTbb treat this as ending the year, default the rest
+ RDTWOC(hh,0,24);  // 24 allowed at midnight
+ if((c<0x40) & (((I)1<<'+')|((I)1<<'-')|((I)1<<' ')|((I)1<<0))>>c){mm=ss=0; if((c&~' '))goto hittz; goto gottime;}
+ if(c==':')c=*++sp;  // skip ':' if present
+ RDTWOC(mm,0,59);
+ if((c<0x40) & (((I)1<<'+')|((I)1<<'-')|((I)1<<' ')|((I)1<<0))>>c){ss=0; if((c&~' '))goto hittz; goto gottime;}
+ if(c==':')c=*++sp;  // skip ':' if present
+ RDTWOC(ss,0,60);  // 60 allowed for leap second
+gotsec: ;
+ // If the seconds have decimal extension, turn it to nanoseconds.  ISO8601 allows fractional extension on the last time component even if it's not SS, but we don't support that 
+ if((c=='.')|(c==',')){
+  c=*++sp;  // skip decimal point
+  DO(prec, if(!ISDIGIT(c))break; N+=nanopowers[i]*((UI)c-(UI)'0'); c=*++sp;)  // harder than it looks!  We use memory to avoid long carried dependency from the multiply chain
+  // discard trailing digits that we are skipping
+  NOUNROLL while(ISDIGIT(c))c=*++sp;
+ }
+hittz:
+ // Timezone [+-]HH[[:]MM]  or Z
+ if((c=='+')|(c=='-')){
+  I4 tzisplus=2*(c=='+')-1;   // +1 for +, -1 for -
+  c=*++sp;  // skip tz indic
+  I4 tzhm; RDTWOC(tzhm,0,23);
+  // Apply tz adjustment to hours.  This may make hours negative; that's OK
+  hh-=tzisplus*tzhm;    // +tz means UTC was advanced by tz hours; undo it
   if(c==':')c=*++sp;  // skip ':' if present
-  RDTWOC(ss,0,60);  // 60 allowed for leap second
-  // If the seconds have decimal extension, turn it to nanoseconds.  ISO8601 allows fractional extension on the last time component even if it's not SS, but we don't support that 
-  if((c=='.')|(c==',')){
-   c=*++sp;  // skip decimal point
-   DO(prec, if(!ISDIGIT(c))break; N+=nanopowers[i]*((UI)c-(UI)'0'); c=*++sp;)  // harder than it looks!  We use memory to avoid long carried dependency from the multiply chain
-   // discard trailing digits that we are skipping
-   NOUNROLL while(ISDIGIT(c))c=*++sp;
+  if(ISDIGIT(c)){
+   RDTWOC(tzhm,0,59);
+   mm-=tzisplus*tzhm;    // same for minutes, may go negative
   }
-hittz:
-  // Timezone [+-]HH[[:]MM]  or Z
-  if((c=='+')|(c=='-')){
-   I4 tzisplus=2*(c=='+')-1;   // +1 for +, -1 for -
-   c=*++sp;  // skip tz indic
-   I4 tzhm; RDTWOC(tzhm,0,23);
-   // Apply tz adjustment to hours.  This may make hours negative; that's OK
-   hh-=tzisplus*tzhm;    // +tz means UTC was advanced by tz hours; undo it
-   if(c==':')c=*++sp;  // skip ':' if present
-   if(ISDIGIT(c)){
-    RDTWOC(tzhm,0,59);
-    mm-=tzisplus*tzhm;    // same for minutes, may go negative
-   }
-   N+=local;  // adjust to user's tz
-  }else if(c=='Z'){N+=local; c=*++sp;}  // no numbered timezone; skip Zulu timezone if given, but adjust to user's tz
-  // Verify no significance after end
-  NOUNROLL while(c){if(c!=' ')DOERR; c=*++sp;}
+  N+=local;  // adjust to user's tz
+ }else if(c=='Z'){N+=local; c=*++sp;}  // no numbered timezone; skip Zulu timezone if given, but adjust to user's tz
+ // Verify no significance after end
+ NOUNROLL while(c){if(c!=' ')DOERR; c=*++sp;}
 gottime: ;
-  // We have all the components.  Combine Y M D hh mm ss N into nanosec time
-  // This copies the computation in eft except that we have N here.  eft uses unsigned vbls for hh,mm, we don't - no problem
+ // We have all the components.  Combine Y M D hh mm ss N into nanosec time
+ // This copies the computation in eft except that we have N here.  eft uses unsigned vbls for hh,mm, we don't - no problem
+
+ // Now calculate number of days from epoch.  First reorder months so that the irregular February comes last, i. e. make the year start Mar 1
+ UI4 janfeb=(I4)(M-3)>>(32-1);   // -1 if jan/feb
+ Y+=janfeb; M+=janfeb&12;  // if janfeb, subtract 1 from year and add 12 to month
+ // Add in leap-years (since the year 0, for comp. ease).  Year 2000 eg, which starts Mar 1, is a leap year and has 1 added to its day#s (since they come after Feb 29)
+ D+=Y>>2;
+ // Gregorian correction.  Since it is very unlikely we will encounter a date that needs correcting, we use an IF
+ if(!BETWEENC(Y,1901,2099)){  // date is outside 1901-2099
+  D+=(((Y/100)>>2)-(Y/100))-((2000/400)-(2000/100));  // 1900 2100 2200 2300 2500 etc are NOT leapyears.  Create correction from Y2000 count
+ }
+ // Add in extra days for earlier 31-day months in this adjusted year (so add 0 in March)
+ D+=(0x765544322110000>>(4*M))&0xf;  // starting with month 0, this is x x x 0 1 1 2 2 3 4 4 5 5 6 7
+ // Calculate day from YMD.  Bias from day# of 20000101, accounting for leap-years from year 0 to that date.  Note 20000101 is NOT in a leapyear - it is in year 1999 here
+ // The bias includes: subtracting 1 from day#; subtracting 1 from month#; Jan/Feb of 1999; Gregorian leapyears up to 2000
+ I t=(I)(365*Y + 30*M + D) - 730531;  // day# from epoch.  May be negative
+ // Combine everything into one # and store
+ R (NANOS*24LL*60LL*60LL)*t + (NANOS*3600LL)*hh + (NANOS*60LL)*mm + NANOS*ss + N;  // eschew Horner's Rule because of multiply latency
+#undef DOERR
+#undef RDTWOC
+}
 
-  // Now calculate number of days from epoch.  First reorder months so that the irregular February comes last, i. e. make the year start Mar 1
-  UI4 janfeb=(I4)(M-3)>>(32-1);   // -1 if jan/feb
-  Y+=janfeb; M+=janfeb&12;  // if janfeb, subtract 1 from year and add 12 to month
-  // Add in leap-years (since the year 0, for comp. ease).  Year 2000 eg, which starts Mar 1, is a leap year and has 1 added to its day#s (since they come after Feb 29)
-  D+=Y>>2;
-  // Gregorian correction.  Since it is very unlikely we will encounter a date that needs correcting, we use an IF
-  if(!BETWEENC(Y,1901,2100)){  // date is outside 1901-2099
-   D+=(((Y/100)>>2)-(Y/100))-((2000/400)-(2000/100));  // 1900 2100 2200 2300 2500 etc are NOT leapyears.  Create correction from Y2000 count
+#define EFSMAXLEN 255  // longest string that can be copied to parse the last row of a task
+// parse a block of rows of ISO strings
+static unsigned char jtefsx(J jt,void *ctx,UI4 ti){DTCTX *c=ctx;
+ I strglen=c->len; UC afterday=(UC)((~c->prec)>>8);  //  0x00 if we stop  after the day, 0xff if we continue
+ I b=ti*c->rowspertask, e=MIN(b+c->rowspertask,c->n);  // the block of rows for this task
+ UC *s=(UC*)c->wv+b*strglen; I *z=(I*)c->zv;
+ for(I i=b;i<e;++i,s+=strglen){
+  if((i==e-1)&(e<c->n)){  // the byte after the last row of a task is the first byte of the next task's rows: parse a copy instead
+   UC buf[EFSMAXLEN+1]; MC(buf,s,strglen); buf[strglen]=0; z[i]=efs1(buf,strglen,afterday,c->prec,c->local); break;
   }
-  // Add in extra days for earlier 31-day months in this adjusted year (so add 0 in March)
-  D+=(0x765544322110000>>(4*M))&0xf;  // starting with month 0, this is x x x 0 1 1 2 2 3 4 4 5 5 6 7
-  // Calculate day from YMD.  Bias from day# of 20000101, accounting for leap-years from year 0 to that date.  Note 20000101 is NOT in a leapyear - it is in year 1999 here
-  // The bias includes: subtracting 1 from day#; subtracting 1 from month#; Jan/Feb of 1999; Gregorian leapyears up to 2000
-  I t=(I)(365*Y + 30*M + D) - 730531;  // day# from epoch.  May be negative
-  // Combine everything into one # and store
-  IAV(z)[i]=(NANOS*24LL*60LL*60LL)*t + (NANOS*3600LL)*hh + (NANOS*60LL)*mm + NANOS*ss + N;  // eschew Horner's Rule because of multiply latency
-
-err:
+  // It's OK to overfetch from a string buffer, as long as you don't rely on the contents fetched.  They're padded
+  // We will store an invalid byte on top of the character after the end of the string.  We'll be sure to restore it!
+  UC savesentinel = s[strglen]; s[strglen]=0;  // install end-of-string marker
+  z[i]=efs1(s,strglen,afterday,c->prec,c->local);
   s[strglen]=savesentinel;  // restore end-of-string marker
  }
+ R 0;
+}
+
+// w is LIT array of ISO strings (rank>0, not empty), result is array of INTs with nanosecond time for each string
+// We don't bother to support a boxed-string version because the strings are shorter than the boxes & it is probably just about as good to just open the boxed strings
+// prec is -1 (day only) or 0,3,9 for that many fractional digits below seconds
+// if local is given we convert all UTC times to times in the 'local' zone, where local is in seconds
+static A efs(J jt,A w,I prec,I local){
+#if SY_64
+ A z;
+ // Allocate result area
+ I n; PROD(n,AR(w)-1,AS(w)); GATV(z,INT,n,AR(w)-1,AS(w))
+ I strglen=AS(w)[AR(w)-1];
+ DTCTX c={.wv=CAV(w), .zv=CAV(z), .n=n, .len=strglen, .prec=prec, .local=local};
+ dtrun(jt,jtefsx,&c,strglen>EFSMAXLEN?IMAX:DTMINROWS);  // rows too long to copy are parsed in one task
  RETF(z);
 #else
 R 0;
@@ -995,6 +1086,7 @@ R 0;
 
 
 
+
 // 6!:14 Convert a block of integer yyyymmddHHMMSS to nanoseconds from year 2000
 F1(jtinttoe){A z;I n;
  ARGCHK1(w);
@@ -1002,7 +1094,8 @@ F1(jtinttoe){A z;I n;
  ASSERT(SY_64,EVNONCE);
  RZ(w=vi(w));  // verify valid integer
  GATV(z,INT,n,AR(w),AS(w));
- eft(n,IAV(z),IAV(w));
+ DTCTX c={.wv=CAV(w), .zv=CAV(z), .n=n};
+ dtrun(jt,jteftx,&c,DTMINROWS);
  RETF(z);
 }
 
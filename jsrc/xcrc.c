@@ -1,10 +1,11 @@
 /* Copyright (c) 1990-2024, Jsoftware Inc.  All rights reserved.           */
 /* Licensed use only. Any other use is in violation of copyright.          */
 /*                                                                         */
-/* Xenos: CRC calculation and base64 encode/decode                         */
+/* Xenos: CRC calculation, hashing and base64 encode/decode                */
 
 #include "j.h"
 #include "x.h"
+#include "crc32c.h"
 
 #include "../base64/include/libbase64.h"
 #if C_AVX2
@@ -15,6 +16,8 @@
 #define B64CODEC BASE64_FORCE_PLAIN
 #endif
 
+#define CRC32CPOLY 0x82f63b78  // CRC-32C (Castagnoli), bit-reflected
+
 // Calculate byte-at-a-time CRC table in *crctab, and return the starting value as the result
 static UINT jtcrcvalidate(J jt,A w, UINT* crctab){A*wv;B*v;I m;UINT p,x,z=-1;
  ARGCHK1(w);
@@ -39,7 +42,8 @@ F2(jtcrc2){I n;UINT z;UC*v; UINT crctab[256];
  ASSERT(!n||AT(w)&LIT,EVDOMAIN);
  RE(z=crcvalidate(a,crctab));
  n=AT(w)&C4T?(4*n):AT(w)&C2T?n+n:n;
- DQ(n, z=z>>8^crctab[255&(z^*v++)];);  // do the computation using unsigned z
+ if(crctab[128]==CRC32CPOLY)z=crc32cbuf(z,v,n);  // crctab[128] is the polynomial.  CRC-32C has a faster path
+ else DQ(n, z=z>>8^crctab[255&(z^*v++)];);  // do the computation using unsigned z
  R sc((I)(I4)(z^-1L));  // sign-extend result if needed to make 64-bit and 32-bit the same numeric value
 }
 
@@ -58,7 +62,8 @@ DF1(jtcrcfixedleft){A h,*hv;I n;UINT*t,z;UC*v;
  n=AN(w); v=UAV(w);
  ASSERT(!n||AT(w)&LIT+C2T+C4T,EVDOMAIN);
  n=AT(w)&C4T?(4*n):AT(w)&C2T?n+n:n;
- DQ(n, z=z>>8^t[255&(z^*v++)];);
+ if(t[128]==CRC32CPOLY)z=crc32cbuf(z,v,n);
+ else DQ(n, z=z>>8^t[255&(z^*v++)];);
  R sc((I)(I4)(z^-1L));
 }
 
@@ -87,6 +92,153 @@ F2(jtqhash12){F2PREFIP; I hsiz; UI crc;
  R sc((I)(I4)crc);   // make the result a valid integer.  Could reuse the a arg inplace
 }
 
+// 128!:26 XXH3 64-bit hash of each cell, with a seed.  The constants and steps are those of XXH3_64bits_withSeed, so the hash of
+// a cell is the same as other XXH3 implementations give for its bytes.  Cells are hashed by their bytes, so equal values held
+// in different precisions (boolean and integer, say) hash differently.  Boxes are hashed by the bytes of their contents
+static const UC xxsecret[192]={
+ 0xb8,0xfe,0x6c,0x39,0x23,0xa4,0x4b,0xbe,0x7c,0x01,0x81,0x2c,0xf7,0x21,0xad,0x1c,0xde,0xd4,0x6d,0xe9,0x83,0x90,0x97,0xdb,0x72,0x40,0xa4,0xa4,0xb7,0xb3,0x67,0x1f,
+ 0xcb,0x79,0xe6,0x4e,0xcc,0xc0,0xe5,0x78,0x82,0x5a,0xd0,0x7d,0xcc,0xff,0x72,0x21,0xb8,0x08,0x46,0x74,0xf7,0x43,0x24,0x8e,0xe0,0x35,0x90,0xe6,0x81,0x3a,0x26,0x4c,
+ 0x3c,0x28,0x52,0xbb,0x91,0xc3,0x00,0xcb,0x88,0xd0,0x65,0x8b,0x1b,0x53,0x2e,0xa3,0x71,0x64,0x48,0x97,0xa2,0x0d,0xf9,0x4e,0x38,0x19,0xef,0x46,0xa9,0xde,0xac,0xd8,
+ 0xa8,0xfa,0x76,0x3f,0xe3,0x9c,0x34,0x3f,0xf9,0xdc,0xbb,0xc7,0xc7,0x0b,0x4f,0x1d,0x8a,0x51,0xe0,0x4b,0xcd,0xb4,0x59,0x31,0xc8,0x9f,0x7e,0xc9,0xd9,0x78,0x73,0x64,
+ 0xea,0xc5,0xac,0x83,0x34,0xd3,0xeb,0xc3,0xc5,0x81,0xa0,0xff,0xfa,0x13,0x63,0xeb,0x17,0x0d,0xdd,0x51,0xb7,0xf0,0xda,0x49,0xd3,0x16,0x55,0x26,0x29,0xd4,0x68,0x9e,
+ 0x2b,0x16,0xbe,0x58,0x7d,0x47,0xa1,0xfc,0x8f,0xf8,0xb8,0xd1,0x7a,0xd0,0x31,0xce,0x45,0xcb,0x3a,0x8f,0x95,0x16,0x04,0x28,0xaf,0xd7,0xfb,0xca,0xbb,0x4b,0x40,0x7e};
+#define XXP1 0x9E3779B185EBCA87ULL
+#define XXP2 0xC2B2AE3D27D4EB4FULL
+#define XXP3 0x165667B19E3779F9ULL
+#define XXP4 0x85EBCA77C2B2AE63ULL
+#define XXP5 0x27D4EB2F165667C5ULL
+#define XXP32_1 0x9E3779B1ULL
+#define XXP32_2 0x85EBCA77ULL
+#define XXP32_3 0xC2B2AE3DULL
+#define XXSTRIPES ((sizeof(xxsecret)-64)/8)  // stripes of 64 bytes in a block of the long hash
+
+static INLINE UI xxr64(const UC *p){UI v; MC(&v,p,8); R v;}  // little-endian load
+static INLINE UI xxr32(const UC *p){UI4 v; MC(&v,p,4); R v;}
+static INLINE UI xxswap64(UI x){x=((x&0x00ff00ff00ff00ffULL)<<8)|((x>>8)&0x00ff00ff00ff00ffULL); x=((x&0x0000ffff0000ffffULL)<<16)|((x>>16)&0x0000ffff0000ffffULL); R (x<<32)|(x>>32);}
+#define XXROTL(x,r) (((x)<<(r))|((x)>>(64-(r))))
+// fold the 128-bit product of a and b to 64 bits
+static INLINE UI xxfold(UI a,UI b){
+#ifdef DPUMULU
+ UI l,h; DPUMULU(a,b,l,h); R l^h;
+#else
+ UI al=(UI4)a, ah=a>>32, bl=(UI4)b, bh=b>>32, ll=al*bl, hl=ah*bl, lh=al*bh, hh=ah*bh;
+ UI mid=(ll>>32)+(UI4)hl+lh; R ((mid<<32)|(UI4)ll)^(hh+(hl>>32)+(mid>>32));
+#endif
+}
+static INLINE UI xxaval(UI h){h^=h>>37; h*=0x165667919E3779F9ULL; R h^(h>>32);}
+static INLINE UI xx64aval(UI h){h^=h>>33; h*=XXP2; h^=h>>29; h*=XXP3; R h^(h>>32);}
+static INLINE UI xxmix16(UC *p,const UC *s,UI seed){R xxfold(xxr64(p)^(xxr64(s)+seed),xxr64(p+8)^(xxr64(s+8)-seed));}
+
+// accumulate ns stripes from p into acc, using the secret from s on, advancing 8 bytes a stripe
+static INLINE void xxaccum(UI *acc,UC *p,const UC *s,I ns){
+#if C_AVX2
+ __m256i a0=_mm256_loadu_si256((__m256i*)acc), a1=_mm256_loadu_si256((__m256i*)(acc+4));
+ for(I i=0;i<ns;++i,p+=64,s+=8){
+  __m256i d0=_mm256_loadu_si256((__m256i*)p), d1=_mm256_loadu_si256((__m256i*)(p+32));
+  __m256i k0=_mm256_xor_si256(d0,_mm256_loadu_si256((__m256i*)s)), k1=_mm256_xor_si256(d1,_mm256_loadu_si256((__m256i*)(s+32)));
+  // acc[i] += lo32(key)*hi32(key) + data[i^1]
+  a0=_mm256_add_epi64(a0,_mm256_add_epi64(_mm256_mul_epu32(k0,_mm256_srli_epi64(k0,32)),_mm256_shuffle_epi32(d0,_MM_SHUFFLE(1,0,3,2))));
+  a1=_mm256_add_epi64(a1,_mm256_add_epi64(_mm256_mul_epu32(k1,_mm256_srli_epi64(k1,32)),_mm256_shuffle_epi32(d1,_MM_SHUFFLE(1,0,3,2))));
+ }
+ _mm256_storeu_si256((__m256i*)acc,a0); _mm256_storeu_si256((__m256i*)(acc+4),a1);
+#else
+ for(I i=0;i<ns;++i,p+=64,s+=8)DO(8, UI d=xxr64(p+8*i), k=d^xxr64(s+8*i); acc[i^1]+=d; acc[i]+=(k&0xffffffff)*(k>>32);)
+#endif
+}
+
+// scramble the accumulators at the end of each block
+static INLINE void xxscramble(UI *acc,const UC *s){DO(8, UI a=acc[i]; a^=a>>47; a^=xxr64(s+8*i); acc[i]=a*XXP32_1;)}
+
+// inputs longer than 240 bytes: 8 lanes of 64-bit accumulators over 64-byte stripes.  s is the secret, already mixed with the seed
+static UI xxh3long(UC *p,I n,const UC *s){
+ UI acc[8]={XXP32_3,XXP1,XXP2,XXP3,XXP4,XXP32_2,XXP5,XXP32_1};
+ I bl=64*XXSTRIPES, nb=(n-1)/bl;  // bytes in a block, number of full blocks
+ DO(nb, xxaccum(acc,p+i*bl,s,XXSTRIPES); xxscramble(acc,s+sizeof(xxsecret)-64);)
+ xxaccum(acc,p+nb*bl,s,((n-1)-nb*bl)>>6);  // the partial block
+ xxaccum(acc,p+n-64,s+sizeof(xxsecret)-64-7,1);  // the last stripe, which may overlap the one before
+ UI r=(UI)n*XXP1; DO(4, r+=xxfold(acc[2*i]^xxr64(s+11+16*i),acc[2*i+1]^xxr64(s+11+16*i+8));)
+ R xxaval(r);
+}
+
+// hash the n bytes at p.  ls is the secret for long inputs
+static UI xxh3(UC *p,I n,UI seed,const UC *ls){const UC *s=xxsecret;
+ if(n<=16){
+  if(n>8){UI lo=xxr64(p)^((xxr64(s+24)^xxr64(s+32))+seed), hi=xxr64(p+n-8)^((xxr64(s+40)^xxr64(s+48))-seed);
+   R xxaval((UI)n+xxswap64(lo)+hi+xxfold(lo,hi));}
+  if(n>=4){
+   UI sd=seed^(xxswap64((UI4)seed)&0xffffffff00000000ULL);  // seed ^ (byte-reversed low half << 32)
+   UI k=(xxr32(p+n-4)+(xxr32(p)<<32))^((xxr64(s+8)^xxr64(s+16))-sd);
+   k^=XXROTL(k,49)^XXROTL(k,24); k*=0x9FB21C651E98DF25ULL; k^=(k>>35)+n; k*=0x9FB21C651E98DF25ULL; R k^(k>>28);
+  }
+  if(n>0){UI c=((UI)p[0]<<16)|((UI)p[n>>1]<<24)|p[n-1]|((UI)n<<8); R xx64aval(c^((xxr32(s)^xxr32(s+4))+seed));}
+  R xx64aval(seed^xxr64(s+56)^xxr64(s+64));
+ }
+ if(n<=128){UI acc=(UI)n*XXP1;
+  if(n>32){
+   if(n>64){
+    if(n>96){acc+=xxmix16(p+48,s+96,seed); acc+=xxmix16(p+n-64,s+112,seed);}
+    acc+=xxmix16(p+32,s+64,seed); acc+=xxmix16(p+n-48,s+80,seed);
+   }
+   acc+=xxmix16(p+16,s+32,seed); acc+=xxmix16(p+n-32,s+48,seed);
+  }
+  acc+=xxmix16(p,s,seed); acc+=xxmix16(p+n-16,s+16,seed); R xxaval(acc);
+ }
+ if(n<=240){UI acc=(UI)n*XXP1;
+  DO(8, acc+=xxmix16(p+16*i,s+16*i,seed);) acc=xxaval(acc);
+  for(I i=8;i<n>>4;++i)acc+=xxmix16(p+16*i,s+16*(i-8)+3,seed);
+  acc+=xxmix16(p+n-16,s+136-17,seed); R xxaval(acc);
+ }
+ R xxh3long(p,n,ls);
+}
+
+typedef struct {
+ UI seed; UC secret[sizeof(xxsecret)];  // the seed, and the secret for long cells derived from it
+ UC *wv; I wk;  // cell data and bytes per cell; wv=0 for boxes
+ A *bv;  // boxes
+ I *zv;  // result
+ I ncells, cellspertask;  // number of cells, number given to each task
+} XXCTX;
+
+static unsigned char jtxxhashx(J jt,void *ctx,UI4 ti){XXCTX *c=ctx;
+ I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells);
+ // cells do not depend on each other, so the CPU overlaps the hashing of neighbouring cells
+ if(c->wv){UC *p=c->wv+b*c->wk; for(I i=b;i<e;++i,p+=c->wk)c->zv[i]=(I)xxh3(p,c->wk,c->seed,c->secret);}
+ else for(I i=b;i<e;++i){A t=C(c->bv[i]); c->zv[i]=(I)xxh3(UAV(t),AN(t)<<bplg(AT(t)),c->seed,c->secret);}
+ R 0;
+}
+
+#define XXMINBYTES 65536  // TUNE don't start a task for less data than this
+// [x] 128!:26 y: hash of each cell of y.  x is the seed (default 0), or seed,rank to hash the cells of that rank (default _1, the items,
+// except for boxed y, where the default is 0: each box is a cell).
+// The result, one integer per cell, has the frame of y
+F2(jtxxhash2){A z;XXCTX c;
+ ARGCHK2(a,w);
+ ASSERT(AR(a)<=1,EVRANK) ASSERT(BETWEENC(AN(a),1,2),EVLENGTH) RZ(a=vi(a));
+ I r=AN(a)>1?IAV(a)[1]:AT(w)&BOX?0:-1; r=r<0?MAX(0,AR(w)+r):MIN(r,AR(w)); I fr=AR(w)-r;  // rank of cell, of frame
+ ASSERT(!ISSPARSE(AT(w)),EVNONCE)
+ memset(&c,0,sizeof(c)); c.seed=(UI)IAV(a)[0];
+ PROD(c.ncells,fr,AS(w)); I tot;
+ if(AT(w)&BOX){
+  ASSERT(!r,EVRANK)  // each box is a cell
+  c.bv=AAV(w); tot=0;
+  DO(c.ncells, A t=C(c.bv[i]); ASSERT(!AN(t)||(AT(t)&DIRECT&~SBT&&!ISSPARSE(AT(t))),EVDOMAIN) tot+=AN(t)<<bplg(AT(t));)
+ }else{
+  ASSERT(!AN(w)||AT(w)&DIRECT&~SBT,EVDOMAIN)  // symbols are indexes, different in every session
+  PROD(c.wk,r,AS(w)+fr); c.wk<<=bplg(AT(w)); c.wv=UAV(w); tot=AN(w)<<bplg(AT(w));
+ }
+ GATV(z,INT,c.ncells,fr,AS(w)); c.zv=IAV(z);
+ if(!c.ncells)RETF(z);
+ // the secret for cells longer than 240 bytes has the seed folded in
+ DO(sizeof(xxsecret)/16, UI lo=xxr64(xxsecret+16*i)+c.seed, hi=xxr64(xxsecret+16*i+8)-c.seed; MC(c.secret+16*i,&lo,8); MC(c.secret+16*i+8,&hi,8);)
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(XXMINBYTES-tot))>=0)nthreads=1;  // if only one cell, one thread, or a small job, use one thread
+ c.cellspertask=(c.ncells+nthreads-1)/nthreads; nthreads=(c.ncells+c.cellspertask-1)/c.cellspertask;
+ if(nthreads>1)jtjobrun(jt,jtxxhashx,&c,nthreads,0);else jtxxhashx(jt,&c,0);
+ RETF(z);
+}
+#undef XXMINBYTES
+F1(jtxxhash1){R jtxxhash2(jt,zeroionei(0),w);}
+
 // base64 stuff
 #include<assert.h>
 static C base64tab[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -176,16 +176,18 @@ typedef long long I8;
 #endif
 typedef union u_DI8_tag { I8 i; D d; } DI8;
 
-static D jtroundID(J jt,I d,D y){D f,q,c,h;DI8 f8,q8,c8;
+// the rounded value of y times 10^d, an integer-valued D
+static D jtroundIDq(J jt,I d,D y){D f,q,c,h;DI8 f8,q8,c8;
  q=ppwrs[d]*y; if(q<1) h=2; else h=0; q+=h;
  f=jfloor(q); c=-jfloor(-q); 
- if(f==c) R npwrs[d]*(c-h);
+ if(f==c) R c-h;
  ASSERTSYS(f<=q&&q<=c, "roundID: fqc");
  f8.d=f;q8.d=q;c8.d=c;
  ASSERTSYS(0<=f8.i&&0<=q8.i&&0<=c8.i, "roundID: sign");
- if(q8.i-f8.i >= c8.i-q8.i-1) R npwrs[d]*(c-h);
- else                         R npwrs[d]*(f-h);
-} /* round a number in not in exponential notation */
+ if(q8.i-f8.i >= c8.i-q8.i-1) R c-h;
+ else                         R f-h;
+}
+static D jtroundID(J jt,I d,D y){R npwrs[d]*jtroundIDq(jt,d,y);} /* round a number in not in exponential notation */
 
 static D jtafzrndID(J jt,I dp,D y){R SGN(y)*roundID(dp,ABS(y));}
          /* round-to-nearest, solve ties by rounding Away From Zero */
@@ -230,6 +232,14 @@ static B jtsprintfnD(J jt, C *x, I m, I dp, D dw, C *subs) {I nd;int decpt, sign
  R 1;
 }
 
+// r is the value times 10^dp, rounded, with at most 15 digits.  Same result as sprintfnD, without the conversion from D
+static B jtsprintfnI(J jt, C *x, I m, I dp, UI r, C *subs) {
+ x+=m-1;
+ DQ(dp, *x--='0'+(C)(r%10); r/=10;); if(dp) *x--=SUBd;
+ do{*x--='0'+(C)(r%10); r/=10;}while(r);
+ R 1;
+}
+
 static B jtsprintfeD(J jt, C *x, I m, I dp, D dw, C *subs) {I y,y0;int decpt,sign;
  RZ(ecvt(dw,1+dp,&decpt,&sign,x+!!dp));
  if(dp) { x[0]=x[1]; x[1]=SUBd; }
@@ -377,7 +387,9 @@ static F2(jtfmtprecomp) {A*as,base,fb,len,strs,*u,z;B*bits,*bw;D dtmp,*dw;
         if(B01&wt) *iv=1+!!d+d;
         else {
          if(B01&wt) dtmp=1; if(INT&wt) dtmp=(D)*iw; else dtmp=*dw;
-         *iv=(I)jfloor(log10(roundID(d,MAX(ABS(dtmp),1))));
+         dtmp=roundIDq(d,MAX(ABS(dtmp),1));  // the value times 10^d, which has the same digits as the display
+         if(dtmp<1e15){UI r=(UI)dtmp; *iv=-1-d; do ++*iv; while(r/=10);}else *iv=(I)jfloor(log10(npwrs[d]*dtmp));
+         dtmp=INT&wt?(D)*iw:*dw;
          if(mC) (*iv)+=(*iv)/3;
          (*iv)+=1+!!d+d;
          if(dtmp < 0 && mMN) (*iv)+=nMN;
@@ -396,73 +408,34 @@ static F2(jtfmtprecomp) {A*as,base,fb,len,strs,*u,z;B*bits,*bw;D dtmp,*dw;
  R z;
 } /* format: precomputation to separate the group and column concept */
 
-/* a is jtfmtprecomp result */
-/* w is argument to format, but with BO1, INT, or FL type. */
-static A jtfmtallcol(J jt, A a, A w, I mode) {A *a1v,base,fb,len,strs,*u,v,x;
-    B *bits,*bv;C*cB,*cD,*cM,*cN,*cP,*cQ,*cR,*cI,*cv,**cvv,*cx,*subs;D dtmp,*dv;
-    I coll,d,g,h,i,*ib,imod,*iv,*il,j,k,l,m,mods,nB,nD,nM,nN,nP,nQ,nR,nI,n,nc,nf,t,wr,*ws,y,zs[2];
- ARGCHK1(a); u=AAV(a); base=*u++; strs=*u++; len=*u++; fb=*u++; u=0; subs=0;  // extract components: len->lengths of the values
- ARGCHK1(w); n=AN(w); t=AT(w); wr=AR(w); ws=AS(w); SHAPEN(w,wr-1,nc); 
- ASSERT(ISDENSETYPE(t,B01+INT+FL), EVDOMAIN);
-
- nf=1==AR(base)?1:AS(base)[0];
- switch(mode){
-  case 0:
-   GATV(x, BOX, n, wr, ws); a1v=AAV(x); il=AV(len);
-   ib=AV(base);
-   imod=1;
-   DO(n, 
-    ib+=4; --imod; ib=(imod==0)?AV(base):ib; imod=(imod==0)?nf:imod;
-    if(0<ib[0]) GATV0(*a1v, LIT, ib[0], 1)
-    else GATV0(*a1v, LIT, *il, 1) 
-    incorp(*a1v); mvc( AN(*a1v),CAV(*a1v),1,iotavec-IOTAVECBEGIN+' '); 
-    a1v++; il++; 
-   );
-   break;
-  case 1:
-   GATV0(x, BOX, nc, 1); a1v=AAV(x); ib=AV(base); zs[0]=prod(wr-1,ws);
-   GATV0(v, LIT, nc*SZA, 1); cvv=(C**)AV(v); 
-   DO(nc,
-    if(0<ib[0]) zs[1]=ib[0]; 
-    else zs[1]=ib[3+(1<nf?0:i)]; 
-    GATVR(*a1v, LIT, zs[0]*zs[1], 2, zs);
-    incorp(*a1v); mvc( AN(*a1v),CAV(*a1v),1,iotavec-IOTAVECBEGIN+' '); 
-    *cvv++=CAV(*a1v);
-    a1v++; if(1<nf) ib+=4; 
-   );
-   cvv=(C**)AV(v);
-   break;
-  case 2:
-   coll=0; ib=AV(base);
-   DO(nc, if(0<ib[0]) coll+=ib[0]; else coll+=ib[3+(1<nf?0:i)];
-          if(1<nf) ib+=4; );
-   zs[0]=prod(wr-1,ws); zs[1]=coll;
-   GATVR(x, LIT, zs[0]*zs[1], 2, zs);
-   mvc( AN(x),CAV(x),1,iotavec-IOTAVECBEGIN+' ');
-   break;
-  default: ASSERTSYS(0, "jtfmtallcol: mode");
- }
- 
- a1v=AAV(x); cx=CAV(x);  il=AV(len); bits=BAV(fb);
- bv=BAV(w); iv=IAV(w); dv=DAV(w);
- 
- u=AAV(strs)-1; ib=AV(base); j=h=0;
- for(i=0;i<n;i++) {
-  if(1<nf) {
-   if(h==nf) h=0;
-   if(h) { ib += 4; u += NMODVALS; } 
-   else { ib=AV(base); u=AAV(strs)-1; }
-  }
-  if(j==nc) j=0;
-  k=l=ib[0]; d=ib[1]; mods=ib[2]; coll=ib[3+(I )(1==nf)*j];
+typedef struct {
+ A base, strs;  // phrase parms, and strings, from jtfmtprecomp
+ I *len; B *fb;  // length and bitflags of each value
+ A w; I nc, nf, nr, rowspertask;  // values, #columns, #phrases, #rows, rows given to each task
+ A *a1v;  // mode 0: box for each value
+ C **cvv; I *cw;  // mode 1: start of the table for each column, and its width
+ C *cx; I *coff, coll;  // mode 2: the result, offset of each column in a row, and the row length
+ I mode;
+} FMTALLCTX;
+
+#define FMTRZ(e) if(unlikely(!(e)))R jt->jerr?jt->jerr:EVSYSTEM;
+// format the rows given to task ti
+static unsigned char jtfmtallcolx(J jt,void *ctx,UI4 ti){FMTALLCTX *c=ctx;A *u;
+    B *bits,*bv;C*cB,*cD,*cM,*cN,*cP,*cQ,*cR,*cI,*cv,*subs;D dtmp,*dv;
+    I coll,d,g,i,*ib,*iv,*il,j,k,l,m,mods,nB,nD,nM,nN,nP,nQ,nR,nI,nc=c->nc,t=AT(c->w),y;
+ if(setjmp(((struct dtoa_info*)jt->dtoa)->_env))R jt->jerr?jt->jerr:EVSYSTEM;  // catch out-of-memory errors from dtoa.c, in whatever thread we are in
+ I r0=ti*c->rowspertask, r1=MIN(r0+c->rowspertask,c->nr);
+ for(I r=r0;r<r1;++r)for(j=0;j<nc;++j){
+  i=r*nc+j; il=c->len+i; bits=c->fb+i; bv=BAV(c->w)+i; iv=IAV(c->w)+i; dv=DAV(c->w)+i;
+  I h=1<c->nf?j:0; ib=AV(c->base)+4*h; u=AAV(c->strs)-1+NMODVALS*h;  // phrase for the column
+  k=l=ib[0]; d=ib[1]; mods=ib[2]; coll=ib[3+(I )(1==c->nf)*j];
   nB= AN(uB); nD= AN(uD); nM= AN(uM); nN= AN(uN); nP= AN(uP); nQ= AN(uQ); nR= AN(uR); nI= AN(uI);
   cB=CAV(uB); cD=CAV(uD); cM=CAV(uM); cN=CAV(uN); cP=CAV(uP); cQ=CAV(uQ); cR=CAV(uR); cI=CAV(uI);
   subs=AN(uS)?CAV(uS):(C*)"e,.-*";
-  switch(mode) {
-   case 0: v=*a1v; cv=CAV(v); break;
-   case 1: k=0<l?l:coll; cv=cvv[j]; cvv[j]+=k; break;
-   case 2: k=0<l?l:coll; cv=cx; cx+=k; break;
-   default: ASSERTSYS(0, "jtfmtallcol: mode");
+  switch(c->mode) {
+   case 0: cv=CAV(c->a1v[i]); break;
+   case 1: k=0<l?l:coll; cv=c->cvv[j]+r*k; break;
+   default: k=0<l?l:coll; cv=c->cx+r*c->coll+c->coff[j]; break;
   }
   if(l>0 && l<*il) mvc(l,cv,1,iotavec-IOTAVECBEGIN+(SUBs));  // can't dereference il if l==0.  If field too short, fill with user's * character
   else {
@@ -480,7 +453,7 @@ static A jtfmtallcol(J jt, A a, A w, I mode) {A *a1v,base,fb,len,strs,*u,v,x;
     if(mB) MC(cv, cB, nB);  // if b<xx> given, use it
     else {
      if(mPQ) { MC(cv, cP, nP); MC(cv+*il-nQ, cQ, nQ); }  // if p<xx> or q<xx> given, move in those fields
-     RZ(sprintfI(cv+nP,*il-nP-nQ,d,0,subs));  // format 0 into the field, skipping p/q
+     FMTRZ(sprintfI(cv+nP,*il-nP-nQ,d,0,subs));  // format 0 into the field, skipping p/q
     }
    } else if(mI && t&INT && *iv==IMIN){MC(cv, cI, nI);  // if we are checking for NULL, that overrides exponential
    } else if(*bits&BITSe) {  // is nonzero to be displayed in exponential notation?  (must be INT or FL)
@@ -488,7 +461,7 @@ static A jtfmtallcol(J jt, A a, A w, I mode) {A *a1v,base,fb,len,strs,*u,v,x;
     y=dtmp < 0; g=0;    // y will be length of sign prefix; init to 1 if negative.  g is length of sign suffix9
     if(dtmp < 0 && mMN) { y=nM; g=nN; }   // if value is negative and m<xx> or n<xx> given, set pref/suff length from m/n
     else if(dtmp>=0 && mPQ) { y=nP; g=nQ; }   // if value is nonnegative and p<xx> or q<xx> given, set pref/suff length from p/q
-    RZ(sprintfeD(cv+y,*il-y-g,d,exprndID(d,dtmp),subs));  // format the number, skipping pref/suff
+    FMTRZ(sprintfeD(cv+y,*il-y-g,d,exprndID(d,dtmp),subs));  // format the number, skipping pref/suff
     if     (dtmp< 0 && mMN) { MC(cv, cM, nM); MC(cv+*il-nN, cN, nN); }  // if negative & pref/suff given, move them in
     else if(dtmp< 0       ) { *cv=SUBm;                              }   // if other negative, use the specified - sign
     else if(dtmp>=0 && mPQ) { MC(cv, cP, nP); MC(cv+*il-nQ, cQ, nQ); }  // if nonnegative & pref/suff given, move them in
@@ -498,32 +471,92 @@ static A jtfmtallcol(J jt, A a, A w, I mode) {A *a1v,base,fb,len,strs,*u,v,x;
      if(*iv < 0 && mMN) { y=nM; g=nN; }
      else if(*iv>=0 && mPQ) { y=nP; g=nQ; }  // pref/suff length as above
      m=*il-y-g; if(mC) m=m-((m-!!d-d)>>2);  // m=length left for value after pref/suff, and any added commas
-     RZ(sprintfI(cv+y, m, d, *iv, subs));  // format as integer
-     if(mC) RZ(fmtcomma(cv+y, *il-y-g, d, subs));  // insert commas if called for
+     FMTRZ(sprintfI(cv+y, m, d, *iv, subs));  // format as integer
+     if(mC) FMTRZ(fmtcomma(cv+y, *il-y-g, d, subs));  // insert commas if called for
      if     (*iv < 0 && mMN) { MC(cv, cM, nM); MC(cv+*il-nN, cN, nN); }  // install pref/suff as above
      else if(*iv < 0       ) { *cv=SUBm;                              }
      else if(*iv>= 0 && mPQ) { MC(cv, cP, nP); MC(cv+*il-nQ, cQ, nQ); }
     }else if(t<INT){  // B01
      if(mPQ) { MC(cv, cP, nP); MC(cv+*il-nQ, cQ, nQ); }
-     RZ(sprintfI(cv+nP, *il-nP-nQ, d, *bv, subs));
+     FMTRZ(sprintfI(cv+nP, *il-nP-nQ, d, *bv, subs));
     }else{  // FL to be displayed in fixed point, as above but with decimal places
      y=*dv < 0; g=0;
      if(*dv < 0 && mMN) { y=nM; g=nN; }
      else if(*dv>=0 && mPQ) { y=nP; g=nQ; }
      m=*il-y-g; if(mC) m=m-((m-!!d-d)>>2);
-     RZ(sprintfnD(cv+y, m, d, afzrndID(d,*dv), subs));  // round to the display precision
-     if(mC) RZ(fmtcomma(cv+y, *il-y-g, d, subs));
+     dtmp=roundIDq(d,ABS(*dv));  // round to the display precision
+     if(dtmp<1e15)sprintfnI(cv+y, m, d, (UI)dtmp, subs); else FMTRZ(sprintfnD(cv+y, m, d, SGN(*dv)*npwrs[d]*dtmp, subs));
+     if(mC) FMTRZ(fmtcomma(cv+y, *il-y-g, d, subs));
      if     (*dv < 0 && mMN) { MC(cv, cM, nM); MC(cv+*il-nN, cN, nN); }
      else if(*dv < 0       ) { *cv=SUBm;                              }
      else if(*dv>= 0 && mPQ) { MC(cv, cP, nP); MC(cv+*il-nQ, cQ, nQ); }
     }
    }
   }
-  a1v++; il++; bits++; bv++; iv++; dv++; h++; j++;
  }
- 
+ R 0;
+}
+#undef FMTRZ
+
+/* a is jtfmtprecomp result */
+/* w is argument to format, but with BO1, INT, or FL type. */
+// The result is allocated here and the rows are formatted by jtfmtallcolx, divided among the threads of threadpool 0
+#define FMTMINATOMS 2048  // TUNE no task gets fewer values than this
+static A jtfmtallcol(J jt, A a, A w, I mode) {A *a1v,base,fb,len,strs,*u,v,x;FMTALLCTX c;
+    I coll,i,*ib,imod,*il,n,nc,nf,t,wr,*ws,zs[2];
+ ARGCHK1(a); u=AAV(a); base=*u++; strs=*u++; len=*u++; fb=*u++; u=0;  // extract components: len->lengths of the values
+ ARGCHK1(w); n=AN(w); t=AT(w); wr=AR(w); ws=AS(w); SHAPEN(w,wr-1,nc); 
+ ASSERT(ISDENSETYPE(t,B01+INT+FL), EVDOMAIN);
+
+ nf=1==AR(base)?1:AS(base)[0];
+ memset(&c,0,sizeof(c)); c.mode=mode;
+ switch(mode){
+  case 0:
+   GATV(x, BOX, n, wr, ws); a1v=AAV(x); il=AV(len);
+   ib=AV(base);
+   imod=1;
+   DO(n, 
+    ib+=4; --imod; ib=(imod==0)?AV(base):ib; imod=(imod==0)?nf:imod;
+    if(0<ib[0]) GATV0(*a1v, LIT, ib[0], 1)
+    else GATV0(*a1v, LIT, *il, 1) 
+    incorp(*a1v); mvc( AN(*a1v),CAV(*a1v),1,iotavec-IOTAVECBEGIN+' '); 
+    a1v++; il++; 
+   );
+   c.a1v=AAV(x);
+   break;
+  case 1:
+   GATV0(x, BOX, nc, 1); a1v=AAV(x); ib=AV(base); zs[0]=prod(wr-1,ws);
+   GATV0(v, INT, 2*nc, 1); c.cvv=(C**)AV(v); c.cw=AV(v)+nc;
+   DO(nc,
+    if(0<ib[0]) zs[1]=ib[0]; 
+    else zs[1]=ib[3+(1<nf?0:i)]; 
+    GATVR(*a1v, LIT, zs[0]*zs[1], 2, zs);
+    incorp(*a1v); mvc( AN(*a1v),CAV(*a1v),1,iotavec-IOTAVECBEGIN+' '); 
+    c.cvv[i]=CAV(*a1v); c.cw[i]=zs[1];
+    a1v++; if(1<nf) ib+=4; 
+   );
+   break;
+  case 2:
+   coll=0; ib=AV(base);
+   GATV0(v, INT, nc, 1); c.coff=AV(v);
+   DO(nc, c.coff[i]=coll; if(0<ib[0]) coll+=ib[0]; else coll+=ib[3+(1<nf?0:i)];
+          if(1<nf) ib+=4; );
+   zs[0]=prod(wr-1,ws); zs[1]=coll;
+   GATVR(x, LIT, zs[0]*zs[1], 2, zs);
+   mvc( AN(x),CAV(x),1,iotavec-IOTAVECBEGIN+' ');
+   c.cx=CAV(x); c.coll=coll;
+   break;
+  default: ASSERTSYS(0, "jtfmtallcol: mode");
+ }
+ c.base=base; c.strs=strs; c.len=AV(len); c.fb=BAV(fb); c.w=w; c.nc=nc; c.nf=nf; c.nr=n/nc;
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-nthreads)&(FMTMINATOMS-n))>=0)nthreads=1;  // one thread, or a small job
+ nthreads=MIN(nthreads,MAX(1,n/FMTMINATOMS)); nthreads=MIN(nthreads,c.nr); c.rowspertask=(c.nr+nthreads-1)/nthreads;
+ C e=nthreads>1?jtjobrun(jt,jtfmtallcolx,&c,nthreads,0):jtfmtallcolx(jt,&c,0);
+ ASSERT(!e,e);
  R x;
 } /* format w */
+#undef FMTMINATOMS
 
 static A jtfmtxi(J jt, A a, A w, I mode, I *omode){I lvl;
  ARGCHK2(a,w); *omode=0;
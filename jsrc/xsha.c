@@ -30,6 +30,7 @@
 #include "openssl/sha/md5.h"
 #include "openssl/sha/sha.h"
 #include "openssl/sha/sha3.h"
+#include "crc32c.h"
 
 static const char *hex_digits = "0123456789abcdef";
 
@@ -47,6 +48,199 @@ static UC* tohex(UC* dest, UC* src, I len)
   R dest;
 }
 
+/*
+ 1    SHA1
+ 2    SHA224
+ 3    SHA256
+ 4    SHA384
+ 5    SHA512
+ 6    SHA3_224
+ 7    SHA3_256
+ 8    SHA3_384
+ 9    SHA3_512
+ 10   KECCAK_224
+ 11   KECCAK_256
+ 12   KECCAK_384
+ 13   KECCAK_512
+ 14   MD4
+ 15   MD5
+ 16   CRC32C
+*/
+static const UC hashlen[17]={0,20,28,32,48,64,28,32,48,64,28,32,48,64,16,16,4};  // digest length for each algorithm
+
+// hardwared optimized openssl failed to build,
+// SHA1 SHA224 SHA256 for armv8 x86_64
+// use other sources
+
+// Hash state.  The one-shot 128!:6 and the incremental 128!:25 both go through hinit/hupdate/hfinal.
+// 128!:25 keeps the state in a byte list.  The only pointers in it are the meth functions of KECCAK1600_CTX, which this build never
+// sets or calls: hinit leaves them 0 and hstate clears them.  hinit clears the whole state, so equal histories give equal states
+typedef struct {
+ I alg;  // algorithm number, negative for a raw result
+ union {SHA_CTX sha1; SHA256_CTX sha256; SHA512_CTX sha512; KECCAK1600_CTX keccak; MD4_CTX md4; MD5_CTX md5; UI4 crc;} u;
+} HASHST;
+
+// start a hash.  Result is the digest length, 0 if the algorithm is unknown
+static I hinit(HASHST *h,I s){I a=(s>0)?s:-s;
+ if(!BETWEENC(a,1,16))R 0;
+ memset(h,0,sizeof(*h));  // no stray bytes in the padding or the unused part of the union
+ h->alg=s;
+ switch(a){
+ case 1: SHA1_Init(&h->u.sha1); break;
+ case 2: SHA224_Init(&h->u.sha256); break;
+ case 3: SHA256_Init(&h->u.sha256); break;
+ case 4: SHA384_Init(&h->u.sha512); break;
+ case 5: SHA512_Init(&h->u.sha512); break;
+ case 14: MD4_Init(&h->u.md4); break;
+ case 15: MD5_Init(&h->u.md5); break;
+ case 16: h->u.crc=~0U; break;
+ default: sha3_reset(&h->u.keccak); sha3_init(&h->u.keccak, (a>=10)?0x01:0x06, hashlen[a]*8); break;  // 6-13, SHA3 and KECCAK
+ }
+ R hashlen[a];
+}
+
+static void hupdate(HASHST *h,UC *v,I n){I a=(h->alg>0)?h->alg:-h->alg;
+ switch(a){
+ case 1: SHA1_Update(&h->u.sha1,v,n); break;
+ case 2: SHA224_Update(&h->u.sha256,v,n); break;
+ case 3: SHA256_Update(&h->u.sha256,v,n); break;
+ case 4: SHA384_Update(&h->u.sha512,v,n); break;
+ case 5: SHA512_Update(&h->u.sha512,v,n); break;
+ case 14: MD4_Update(&h->u.md4,v,n); break;
+ case 15: MD5_Update(&h->u.md5,v,n); break;
+ case 16: h->u.crc=crc32cbuf(h->u.crc,v,n); break;
+ default: sha3_update(&h->u.keccak,v,n); break;
+ }
+}
+
+// finish the hash into md, which must hold 64 bytes.  h is destroyed
+static void hfinal(HASHST *h,UC *md){I a=(h->alg>0)?h->alg:-h->alg;
+ switch(a){
+ case 1: SHA1_Final(md,&h->u.sha1); break;
+ case 2: SHA224_Final(md,&h->u.sha256); break;
+ case 3: SHA256_Final(md,&h->u.sha256); break;
+ case 4: SHA384_Final(md,&h->u.sha512); break;
+ case 5: SHA512_Final(md,&h->u.sha512); break;
+ case 14: MD4_Final(md,&h->u.md4); break;
+ case 15: MD5_Final(md,&h->u.md5); break;
+ case 16: {UI4 c=~h->u.crc; DO(4, md[i]=(UC)(c>>(24-8*i));)} break;  // big-endian, the way the CRC is usually written
+ default: sha3_final(md,&h->u.keccak); break;
+ }
+}
+
+// store the digest md of length l as raw bytes or hex at z
+static void hstore(UC *z,UC *md,I l,I raw){if(raw)MC(z,md,l); else tohex(z,md,l);}
+
+#if C_AVX2
+static const UI4 sha256k[64]={
+ 0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+ 0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+ 0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+ 0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2};
+static const UI4 sha256iv[2][8]={{0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19},  // SHA-256
+                                 {0xc1059ed8,0x367cd507,0x3070dd17,0xf70e5939,0xffc00b31,0x68581511,0x64f98fa7,0xbefa4fa4}}; // SHA-224
+#define ROR32(x,r) _mm256_or_si256(_mm256_srli_epi32(x,r),_mm256_slli_epi32(x,32-(r)))
+#define BE32(p) (((UI4)(p)[0]<<24)|((UI4)(p)[1]<<16)|((UI4)(p)[2]<<8)|(UI4)(p)[3])
+#define LANEW(t) _mm256_set_epi32(BE32(bp[7]+4*(t)),BE32(bp[6]+4*(t)),BE32(bp[5]+4*(t)),BE32(bp[4]+4*(t)),BE32(bp[3]+4*(t)),BE32(bp[2]+4*(t)),BE32(bp[1]+4*(t)),BE32(bp[0]+4*(t)))
+
+// SHA-256, or SHA-224 if is224, of the nl (<=8) messages lp[i] of length ln[i], one message in each 32-bit lane.
+// The lanes run for the longest message's number of blocks; a lane whose message has ended stops adding into its state.
+// md gets 32 bytes per message
+static void sha256x8(UC **lp,I *ln,I nl,I is224,UC *md){
+ UC tail[8][128]; UC *bp[8]; I nfull[8], nblk[8]; I maxblk=0;
+ for(I l=0;l<8;++l){
+  nfull[l]=nblk[l]=0;
+  if(l>=nl)continue;
+  // the last partial block, the 0x80 terminator and the bit length go into 1 or 2 blocks in tail
+  I n=ln[l], r=n&63, tb=1+(r>=56); nfull[l]=n>>6; nblk[l]=nfull[l]+tb; maxblk=MAX(maxblk,nblk[l]);
+  memset(tail[l],0,128); MC(tail[l],lp[l]+(n&~63),r); tail[l][r]=0x80;
+  UI bits=(UI)n<<3; for(I k=0;k<8;++k)tail[l][tb*64-1-k]=(UC)(bits>>(8*k));
+ }
+ __m256i H[8]; DO(8, H[i]=_mm256_set1_epi32(sha256iv[is224][i]);)
+ __m256i nb=_mm256_set_epi32(nblk[7],nblk[6],nblk[5],nblk[4],nblk[3],nblk[2],nblk[1],nblk[0]);
+ for(I blk=0;blk<maxblk;++blk){
+  for(I l=0;l<8;++l)bp[l]=blk<nfull[l]?lp[l]+64*blk:blk<nblk[l]?tail[l]+64*(blk-nfull[l]):tail[l];  // finished lanes read anything valid
+  __m256i W[16]; DO(16, W[i]=LANEW(i);)
+  __m256i a=H[0], b=H[1], c=H[2], d=H[3], e=H[4], f=H[5], g=H[6], h=H[7];
+  for(I t=0;t<64;++t){
+   if(t>=16){__m256i w15=W[(t-15)&15], w2=W[(t-2)&15];
+    __m256i s0=_mm256_xor_si256(_mm256_xor_si256(ROR32(w15,7),ROR32(w15,18)),_mm256_srli_epi32(w15,3));
+    __m256i s1=_mm256_xor_si256(_mm256_xor_si256(ROR32(w2,17),ROR32(w2,19)),_mm256_srli_epi32(w2,10));
+    W[t&15]=_mm256_add_epi32(_mm256_add_epi32(W[t&15],s0),_mm256_add_epi32(W[(t-7)&15],s1));
+   }
+   __m256i S1=_mm256_xor_si256(_mm256_xor_si256(ROR32(e,6),ROR32(e,11)),ROR32(e,25));
+   __m256i ch=_mm256_xor_si256(_mm256_and_si256(e,f),_mm256_andnot_si256(e,g));
+   __m256i t1=_mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h,S1),_mm256_add_epi32(ch,_mm256_set1_epi32(sha256k[t]))),W[t&15]);
+   __m256i S0=_mm256_xor_si256(_mm256_xor_si256(ROR32(a,2),ROR32(a,13)),ROR32(a,22));
+   __m256i maj=_mm256_or_si256(_mm256_and_si256(a,b),_mm256_and_si256(c,_mm256_or_si256(a,b)));
+   h=g; g=f; f=e; e=_mm256_add_epi32(d,t1); d=c; c=b; b=a; a=_mm256_add_epi32(t1,_mm256_add_epi32(S0,maj));
+  }
+  __m256i act=_mm256_cmpgt_epi32(nb,_mm256_set1_epi32((int)blk));  // lanes whose message is still going
+  H[0]=_mm256_add_epi32(H[0],_mm256_and_si256(act,a)); H[1]=_mm256_add_epi32(H[1],_mm256_and_si256(act,b));
+  H[2]=_mm256_add_epi32(H[2],_mm256_and_si256(act,c)); H[3]=_mm256_add_epi32(H[3],_mm256_and_si256(act,d));
+  H[4]=_mm256_add_epi32(H[4],_mm256_and_si256(act,e)); H[5]=_mm256_add_epi32(H[5],_mm256_and_si256(act,f));
+  H[6]=_mm256_add_epi32(H[6],_mm256_and_si256(act,g)); H[7]=_mm256_add_epi32(H[7],_mm256_and_si256(act,h));
+ }
+ UI4 hv[8][8]; DO(8, _mm256_storeu_si256((__m256i*)hv[i],H[i]);)
+ for(I l=0;l<nl;++l)for(I k=0;k<8;++k){UI4 x=hv[k][l]; md[32*l+4*k]=(UC)(x>>24); md[32*l+4*k+1]=(UC)(x>>16); md[32*l+4*k+2]=(UC)(x>>8); md[32*l+4*k+3]=(UC)x;}
+}
+#endif
+
+// Hashing the cells of an array: the rows of a LIT array, or the contents of boxes.  The cells are divided among the threads of threadpool 0
+typedef struct {
+ I s, dl, zk;  // algorithm, digest length, result bytes per cell
+ UC *wv; I wk;  // LIT data and row length; wv=0 for boxes
+ A *bv;  // boxes
+ UC *zv;  // result
+ I ncells, cellspertask;  // number of cells, number given to each task (a multiple of 8)
+} SHACTX;
+
+static unsigned char jtshacellx(J jt,void *ctx,UI4 ti){SHACTX *c=ctx;
+ I b=ti*c->cellspertask, e=MIN(b+c->cellspertask,c->ncells);
+ I a=(c->s>0)?c->s:-c->s; UC md[8*32];
+#define CELLP(i) (c->wv?c->wv+(i)*c->wk:UAV(C(c->bv[i])))
+#define CELLN(i) (c->wv?c->wk:AN(C(c->bv[i])))
+#if C_AVX2
+ if(BETWEENC(a,2,3)&&!(getCpuFeatures()&CPU_X86_FEATURE_SHA_NI)){  // SHA-224/256: 8 messages at a time, unless the CPU's SHA instructions make one at a time faster
+  for(I i=b;i<e;i+=8){
+   UC *lp[8]; I ln[8]; I nl=MIN(8,e-i);
+   for(I l=0;l<nl;++l){lp[l]=CELLP(i+l); ln[l]=CELLN(i+l);}
+   sha256x8(lp,ln,nl,a==2,md);
+   for(I l=0;l<nl;++l)hstore(c->zv+(i+l)*c->zk,md+32*l,c->dl,c->s<0);
+  }
+  R 0;
+ }
+#endif
+ for(I i=b;i<e;++i){HASHST h; hinit(&h,c->s); hupdate(&h,CELLP(i),CELLN(i)); hfinal(&h,md); hstore(c->zv+i*c->zk,md,c->dl,c->s<0);}
+#undef CELLP
+#undef CELLN
+ R 0;
+}
+
+#define SHAMINBYTES 65536  // TUNE don't start a task for less data than this
+// s 128!:6 on a LIT array of rank>1 or on boxed strings.  The result has the frame of w and a digest for each cell
+static A jtshacells(J jt,I s,A w){A z;SHACTX c;
+ memset(&c,0,sizeof(c));
+ ASSERT(c.dl=hashlen[BETWEENC(s,-16,16)?(s>0)?s:-s:0],EVDOMAIN);
+ c.s=s; c.zk=s<0?c.dl:2*c.dl;
+ I fr=AR(w), tot;  // rank of frame, total bytes to hash
+ if(AT(w)&BOX){
+  c.bv=AAV(w); c.ncells=AN(w); tot=0;
+  DO(c.ncells, A t=C(c.bv[i]); ASSERT(AR(t)<=1,EVRANK) ASSERT(!AN(t)||AT(t)&LIT,EVDOMAIN) tot+=AN(t);)
+ }else{
+  ASSERT(!AN(w)||AT(w)&LIT,EVDOMAIN)
+  --fr; c.wv=UAV(w); c.wk=AS(w)[fr]; PROD(c.ncells,fr,AS(w)); tot=AN(w);
+ }
+ GATV0(z,LIT,c.ncells*c.zk,fr+1); MCISH(AS(z),AS(w),fr) AS(z)[fr]=c.zk; c.zv=UAV(z);
+ if(!c.ncells)RETF(z);
+ ZEROUPPER;  // see jtshasum2
+ I nthreads=(*JT(jt,jobqueue))[0].nthreads+1;
+ if(((1-c.ncells)&(1-nthreads)&(SHAMINBYTES-tot))>=0)nthreads=1;  // if only one cell, one thread, or a small job, use one thread
+ c.cellspertask=((c.ncells+nthreads-1)/nthreads+7)&-8; nthreads=(c.ncells+c.cellspertask-1)/c.cellspertask;
+ if(nthreads>1)jtjobrun(jt,jtshacellx,&c,nthreads,0);else jtshacellx(jt,&c,0);
+ RETF(z);
+}
+
 F1(jtshasum1)
 {
   R shasum2(sc(1),w);
@@ -57,6 +251,8 @@ DF2(jtshasum2)
   I n;
   A z;
   UC *v;
+  ARGCHK2(a,w);
+  if(!AR(a)&&(AT(w)&BOX||AR(w)>1)){I s; RE(s=i0(a)); R jtshacells(jt,s,w);}  // many strings at once
   F2RANK(0,1,jtshasum2,self);  // do rank loop if necessary
   RZ(a=vi(a));
   n=AN(w);
@@ -68,117 +264,51 @@ DF2(jtshasum2)
   // see comment about vzeroupper in io.c
   ZEROUPPER;
 
-  /*
-  1    SHA1
-  2    SHA224
-  3    SHA256
-  4    SHA384
-  5    SHA512
-  6    SHA3_224
-  7    SHA3_256
-  8    SHA3_384
-  9    SHA3_512
-  10   KECCAK_224
-  11   KECCAK_256
-  12   KECCAK_384
-  13   KECCAK_512
-  14   MD4
-  15   MD5
-  */
+  HASHST h; UC md[64]; I l;
+  ASSERT(l=hinit(&h,s),EVDOMAIN);
+  hupdate(&h,v,n); hfinal(&h,md);
+  GATV0(z,LIT,s<0?l:2*l,1); hstore(UAV(z),md,l,s<0);
+  R z;
+}
 
-// hardwared optimized openssl failed to build,
-// SHA1 SHA224 SHA256 for armv8 x86_64
-// use other sources
+// 128!:25 incremental hash, for data too big to hash in one piece.  A state is a byte list holding a HASHST.
+// x 128!:25 y: x is an algorithm number as for 128!:6, which starts a new hash, or a state; the result is the state after hashing y also.
+// 128!:25 y is the digest of state y, the same as x 128!:6 would give on all the bytes hashed
+static HASHST *hstate(J jt,A w,HASHST *h){I a;
+ ASSERT(AT(w)&LIT&&AR(w)==1,EVDOMAIN) ASSERT(AN(w)==sizeof(HASHST),EVLENGTH)
+ MC(h,CAV(w),sizeof(HASHST)); a=(h->alg>0)?h->alg:-h->alg;
+ // audit the state enough that a damaged one cannot run off the end of its buffer
+ ASSERT(BETWEENC(a,1,16),EVDOMAIN)
+ switch(a){
+ case 1: ASSERT(h->u.sha1.num<SHA_CBLOCK,EVDOMAIN) break;
+ case 2: case 3: ASSERT(h->u.sha256.num<SHA256_CBLOCK&&h->u.sha256.md_len==hashlen[a],EVDOMAIN) break;
+ case 4: case 5: ASSERT(h->u.sha512.num<SHA512_CBLOCK&&h->u.sha512.md_len==hashlen[a],EVDOMAIN) break;
+ case 14: ASSERT(h->u.md4.num<MD4_CBLOCK,EVDOMAIN) break;
+ case 15: ASSERT(h->u.md5.num<MD5_CBLOCK,EVDOMAIN) break;
+ case 16: break;
+ default: ASSERT(h->u.keccak.block_size==SHA3_BLOCKSIZE(hashlen[a]*8)&&h->u.keccak.bufsz<h->u.keccak.block_size&&h->u.keccak.md_size==hashlen[a],EVDOMAIN)
+  memset(&h->u.keccak.meth,0,sizeof(h->u.keccak.meth)); break;  // never trust a pointer from a byte list
+ }
+ R h;
+}
 
-  switch((s>0)?s:-s) {
-  case 1: {
-    UC md[20],dh[2*20];
-    SHA1(v, n, md);
-    z = (s<0)?str(20, md):str(2*20, tohex(dh,md,20));
-  }
-  break;
-  case 2: {
-    UC md[32],dh[2*28];
-    SHA224(v, n, md);
-    z = (s<0)?str(28, md):str(2*28, tohex(dh,md,28));
-  }
-  break;
-  case 3: {
-    UC md[32],dh[2*32];
-    SHA256(v, n, md);
-    z = (s<0)?str(32, md):str(2*32, tohex(dh,md,32));
-  }
-  break;
-  case 4: {
-    UC md[64],dh[2*48];
-    SHA384(v, n, md);
-    z = (s<0)?str(48, md):str(2*48, tohex(dh,md,48));
-  }
-  break;
-  case 5: {
-    UC md[64],dh[2*64];
-    SHA512(v, n, md);
-    z = (s<0)?str(64, md):str(2*64, tohex(dh,md,64));
-  }
-  break;
-  case 6:
-  case 10: {
-    UC d[64], dh[2*28];
-    KECCAK1600_CTX c;
-    sha3_reset(&c);
-    sha3_init(&c, (10==((s>0)?s:-s))?0x01:0x06, 28*8);
-    sha3_update(&c, v, n);
-    sha3_final(d, &c);
-    z = (s<0)?str(28, d):str(2*28, tohex(dh,d,28));
-  }
-  break;
-  case 7:
-  case 11: {
-    UC d[64], dh[2*32];
-    KECCAK1600_CTX c;
-    sha3_reset(&c);
-    sha3_init(&c, (11==((s>0)?s:-s))?0x01:0x06, 32*8);
-    sha3_update(&c, v, n);
-    sha3_final(d, &c);
-    z = (s<0)?str(32, d):str(2*32, tohex(dh,d,32));
-  }
-  break;
-  case 8:
-  case 12: {
-    UC d[64], dh[2*48];
-    KECCAK1600_CTX c;
-    sha3_reset(&c);
-    sha3_init(&c, (12==((s>0)?s:-s))?0x01:0x06, 48*8);
-    sha3_update(&c, v, n);
-    sha3_final(d, &c);
-    z = (s<0)?str(48, d):str(2*48, tohex(dh,d,48));
-  }
-  break;
-  case 9:
-  case 13: {
-    UC d[64], dh[2*64];
-    KECCAK1600_CTX c;
-    sha3_reset(&c);
-    sha3_init(&c, (13==((s>0)?s:-s))?0x01:0x06, 64*8);
-    sha3_update(&c, v, n);
-    sha3_final(d, &c);
-    z = (s<0)?str(64, d):str(2*64, tohex(dh,d,64));
-  }
-  break;
-  case 14: {
-    UC md[16],dh[2*16];
-    MD4(v, n, md);
-    z = (s<0)?str(16, md):str(2*16, tohex(dh,md,16));
-  }
-  break;
-  case 15: {
-    UC md[16],dh[2*16];
-    MD5(v, n, md);
-    z = (s<0)?str(16, md):str(2*16, tohex(dh,md,16));
-  }
-  break;
-  default:
-    ASSERT(0,EVDOMAIN);
-  }
-  R z;
+F2(jthashupdate){A z;HASHST h;
+ ARGCHK2(a,w);
+ ASSERT(!AN(w)||AT(w)&LIT,EVDOMAIN) ASSERT(AR(w)<=1,EVRANK)
+ if(AT(a)&LIT){RZ(hstate(jt,a,&h));}
+ else{I s; ASSERT(AT(a)&NUMERIC,EVDOMAIN) ASSERT(!AR(a),EVRANK) RE(s=i0(a)); ASSERT(hinit(&h,s),EVDOMAIN)}
+ ZEROUPPER;
+ hupdate(&h,UAV(w),AN(w));
+ GATV0(z,LIT,sizeof(HASHST),1); MC(CAV(z),&h,sizeof(HASHST));
+ RETF(z);
+}
+
+F1(jthashfinal){A z;HASHST h;UC md[64];
+ ARGCHK1(w);
+ RZ(hstate(jt,w,&h));
+ I a=(h.alg>0)?h.alg:-h.alg, raw=h.alg<0;
+ ZEROUPPER;
+ hfinal(&h,md);
+ GATV0(z,LIT,raw?hashlen[a]:2*hashlen[a],1); hstore(UAV(z),md,hashlen[a],raw);
+ RETF(z);
 }
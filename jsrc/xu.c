@@ -15,6 +15,38 @@ extern size_t utf16le_to_utf8_avx512(unsigned char out[restrict], const char16_t
 extern size_t utf8_to_utf16le_avx512(char16_t out[restrict], const unsigned char in[restrict], size_t len, size_t *outlen);
 #endif
 
+// length of the run of 7-bit characters at the start of s[0..n).  Text is mostly ASCII, so the
+// converters below call these to skip over runs 64 bytes at a time and copy them without decoding.
+// The vector loops find the block containing the first non-ASCII unit; the scalar loop finishes it
+static I asciirun1(UC* s, I n){I r=0;
+#if C_AVX2 || EMU_AVX2
+ for(;r+64<=n;r+=64){if(_mm256_movemask_epi8(_mm256_or_si256(_mm256_loadu_si256((__m256i*)(s+r)),_mm256_loadu_si256((__m256i*)(s+r+32)))))break;}
+ for(;r+32<=n;r+=32){UI4 m=_mm256_movemask_epi8(_mm256_loadu_si256((__m256i*)(s+r))); if(m)R r+CTTZ(m);}
+#endif
+ while(r<n&&s[r]<0x80)++r;
+ R r;
+}
+
+static I asciirun2(US* s, I n){I r=0;
+#if C_AVX2 || EMU_AVX2
+ __m256i hi=_mm256_set1_epi16((short)0xff80);  // bits that must be 0 in an ASCII code unit
+ for(;r+32<=n;r+=32){if(!_mm256_testz_si256(_mm256_or_si256(_mm256_loadu_si256((__m256i*)(s+r)),_mm256_loadu_si256((__m256i*)(s+r+16))),hi))break;}
+ for(;r+16<=n;r+=16){if(!_mm256_testz_si256(_mm256_loadu_si256((__m256i*)(s+r)),hi))break;}
+#endif
+ while(r<n&&s[r]<0x80)++r;
+ R r;
+}
+
+static I asciirun4(C4* s, I n){I r=0;
+#if C_AVX2 || EMU_AVX2
+ __m256i hi=_mm256_set1_epi32((int)0xffffff80);
+ for(;r+16<=n;r+=16){if(!_mm256_testz_si256(_mm256_or_si256(_mm256_loadu_si256((__m256i*)(s+r)),_mm256_loadu_si256((__m256i*)(s+r+8))),hi))break;}
+ for(;r+8<=n;r+=8){if(!_mm256_testz_si256(_mm256_loadu_si256((__m256i*)(s+r)),hi))break;}
+#endif
+ while(r<n&&s[r]<0x80)++r;
+ R r;
+}
+
 // utf-8 to c2v - assumes valid utf-8 data and snk of right size
 void mtow(UC* src, I srcn, US* snk){ US c,c1,c2,c3; UINT t;
   while (srcn--)
@@ -23,6 +55,7 @@ void mtow(UC* src, I srcn, US* snk){ US c,c1,c2,c3; UINT t;
     if(c<0x80)
     {
       *snk++=c;
+      I k=asciirun1(src,srcn); DO(k, snk[i]=src[i];); snk+=k; src+=k; srcn-=k;  // copy the rest of the ASCII run
     }
     else if(c<=0xc1||c>=0xf5)
     {
@@ -125,7 +158,7 @@ I mtowsize(UC* src, I srcn){ US c,c1,c2,c3;UINT t;I r=0;int invalid=0;
     c=*src++;
     if(c<0x80)
     {
-      r++;
+      I k=asciirun1(src,srcn); r+=k+1; src+=k; srcn-=k;
     }
     else if(c<=0xc1||c>=0xf5)
     {
@@ -225,6 +258,7 @@ void mtou(UC* src, I srcn, C4* snk){ US c,c1,c2,c3; UINT t;
     if(c<0x80)
     {
       *snk++=c;
+      I k=asciirun1(src,srcn); DO(k, snk[i]=src[i];); snk+=k; src+=k; srcn-=k;  // copy the rest of the ASCII run
     }
     else if(c<=0xc1||c>=0xf5)
     {
@@ -321,7 +355,7 @@ I mtousize(UC* src, I srcn){ US c,c1,c2,c3;UINT t;I r=0;int invalid=0;
     c=*src++;
     if(c<0x80)
     {
-      r++;
+      I k=asciirun1(src,srcn); r+=k+1; src+=k; srcn-=k;
     }
     else if(c<=0xc1||c>=0xf5)
     {
@@ -416,7 +450,10 @@ void wtom(US* src, I srcn, UC* snk){ US w,w1; UINT t;
  {
   w=*src++;
   if(w<=0x7f)
+  {
    *snk++=(UC)w;
+   I k=asciirun2(src,srcn); DO(k, snk[i]=(UC)src[i];); snk+=k; src+=k; srcn-=k;
+  }
   else if(w<=0x7ff)
   {
    *snk++=0xc0|(w>>6);
@@ -467,7 +504,7 @@ I wtomsize(US* src, I srcn){ US w,w1;I r=0;int invalid=0;
  {
   w=*src++;
   if(w<=0x7f)
-   ++r;
+  {I k=asciirun2(src,srcn); r+=k+1; src+=k; srcn-=k;}
   else if(w<=0x7ff)
    r+=2;
   else if((w>=0x800&&w<=0xd7ff)||(w>=0xe000))
@@ -573,7 +610,10 @@ void utom(C4* src, I srcn, UC* snk){ C4 w;
  {
   w=*src++;
   if(w<=0x7f)
+  {
    *snk++=(UC)w;
+   I k=asciirun4(src,srcn); DO(k, snk[i]=(UC)src[i];); snk+=k; src+=k; srcn-=k;
+  }
   else if(w<=0x7ff)
   {
    *snk++=0xc0|(w>>6);
@@ -613,7 +653,7 @@ I utomsize(C4* src, I srcn){ C4 w;I r=0;int invalid=0;
  {
   w=*src++;
   if(w<=0x7f)
-   ++r;
+  {I k=asciirun4(src,srcn); r+=k+1; src+=k; srcn-=k;}
   else if(w<=0x7ff)
    r+=2;
   else if(BETWEENC(w,0x800,0xffff)&&!BETWEENC(w,0xd800,0xdfff))
@@ -761,7 +801,7 @@ F1(jttoutf16){A z;I n,n1,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; A c4; I *v;
  }
  else if(LIT&t) // u16 from u8
  {
-  DQ(n, if(127<*wv++){b=1;break;});
+  b=asciirun1(wv,n)<n;
   if(!b)RCA(w);  // ascii list unchanged ascii scalar as list
   q=mtowsize(UAV(w),n);
   ASSERT(q>=0,EVDOMAIN);
@@ -778,7 +818,7 @@ F1(jttoutf16){A z;I n,n1,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; A c4; I *v;
  else if(C2T&t)
  {
   c2v=USAV(w);
-  DQ(n, if(127<*c2v++){b=1;break;});
+  b=asciirun2(c2v,n)<n;
   if(b)RCA(w); // u16 unchanged
   GATV0(z,LIT,n,1);
   wv=UAV(z);
@@ -788,7 +828,7 @@ F1(jttoutf16){A z;I n,n1,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; A c4; I *v;
  else
  {
   c4v=C4AV(w);
-  DQ(n, if(127<*c4v++){b=1;break;});
+  b=asciirun4(c4v,n)<n;
   if(b){
   q=utowsize(C4AV(w),n);
   ASSERT(q>=0,EVDOMAIN);
@@ -946,7 +986,7 @@ F1(jttoutf32){A z;I n,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; I* v;
  }
  else if(LIT&t) // u32 from u8
  {
-  DQ(n, if(127<*wv++){b=1;break;});
+  b=asciirun1(wv,n)<n;
   if(!b)RCA(w);  // ascii list unchanged ascii scalar as list
   q=mtousize(UAV(w),n);
   ASSERT(q>=0,EVDOMAIN);
@@ -956,7 +996,7 @@ F1(jttoutf32){A z;I n,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; I* v;
  else if(C2T&t)
  {
   c2v=USAV(w);
-  DQ(n, if(127<*c2v++){b=1;break;});
+  b=asciirun2(c2v,n)<n;
   if(b){
   q=wtousize(USAV(w),n);
   ASSERT(q>=0,EVDOMAIN);
@@ -974,7 +1014,7 @@ F1(jttoutf32){A z;I n,t,q,b=0,j; UC* wv; US* c2v; C4* c4v; I* v;
  else
  {
   c4v=C4AV(w);
-  DQ(n, if(127<*c4v++){b=1;break;});
+  b=asciirun4(c4v,n)<n;
   if(b){
    q=utousize(C4AV(w),n);
    GATV0(z,C4T,q,1);